@@ -0,0 +1,478 @@
+// Copyright Steinwurf ApS 2018.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+// Micro-benchmarks for the individual kslide_* calls. The calls which only
+// query or update state measure the fixed per-call overhead of the C API,
+// while the coding calls are run with tiny and large symbols to separate the
+// overhead from the cost of the finite field arithmetic.
+
+#include <kodo_slide_c/kodo_slide_c.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+// The symbol sizes used: a tiny symbol where the call overhead dominates and
+// a large symbol where the arithmetic dominates
+const int64_t tiny_symbol = 16;
+const int64_t large_symbol = 1400;
+
+// The number of symbols in the coding window for the coding benchmarks
+const uint64_t window_symbols = 32;
+
+void randomize_buffer(std::vector<uint8_t>& buffer)
+{
+    for (auto& value : buffer)
+    {
+        value = rand();
+    }
+}
+
+/// Helper setting up an encoder and decoder with a full window
+struct coders
+{
+    coders(int32_t field, uint64_t symbol_size,
+           int32_t generator = kslide_generator_default) :
+        m_encoder_storage(window_symbols * symbol_size),
+        m_decoder_storage(window_symbols * symbol_size),
+        m_symbol(symbol_size)
+    {
+        m_encoder_factory = kslide_new_encoder_factory();
+        m_decoder_factory = kslide_new_decoder_factory();
+
+        kslide_encoder_factory_set_field(m_encoder_factory, field);
+        kslide_decoder_factory_set_field(m_decoder_factory, field);
+        kslide_encoder_factory_set_symbol_size(m_encoder_factory, symbol_size);
+        kslide_decoder_factory_set_symbol_size(m_decoder_factory, symbol_size);
+        kslide_encoder_factory_set_generator(m_encoder_factory, generator);
+        kslide_decoder_factory_set_generator(m_decoder_factory, generator);
+
+        m_encoder = kslide_encoder_factory_build(m_encoder_factory);
+        m_decoder = kslide_decoder_factory_build(m_decoder_factory);
+
+        randomize_buffer(m_encoder_storage);
+
+        for (uint64_t i = 0; i < window_symbols; ++i)
+        {
+            kslide_encoder_push_front_symbol(
+                m_encoder, m_encoder_storage.data() + i * symbol_size);
+            kslide_decoder_push_front_symbol(
+                m_decoder, m_decoder_storage.data() + i * symbol_size);
+        }
+
+        kslide_encoder_set_window(m_encoder, 0, window_symbols);
+        kslide_decoder_set_window(m_decoder, 0, window_symbols);
+
+        m_coefficients.resize(kslide_encoder_coefficient_vector_size(m_encoder));
+        kslide_encoder_set_seed(m_encoder, 42);
+        kslide_encoder_generate(m_encoder, m_coefficients.data());
+    }
+
+    ~coders()
+    {
+        kslide_delete_encoder(m_encoder);
+        kslide_delete_decoder(m_decoder);
+        kslide_delete_encoder_factory(m_encoder_factory);
+        kslide_delete_decoder_factory(m_decoder_factory);
+    }
+
+    kslide_encoder_factory_t* m_encoder_factory;
+    kslide_decoder_factory_t* m_decoder_factory;
+    kslide_encoder_t* m_encoder;
+    kslide_decoder_t* m_decoder;
+
+    std::vector<uint8_t> m_encoder_storage;
+    std::vector<uint8_t> m_decoder_storage;
+    std::vector<uint8_t> m_symbol;
+    std::vector<uint8_t> m_coefficients;
+};
+
+void set_bytes_processed(benchmark::State& state, uint64_t symbol_size)
+{
+    state.SetBytesProcessed(state.iterations() * symbol_size);
+}
+}
+
+//------------------------------------------------------------------
+// FACTORY API
+//------------------------------------------------------------------
+
+static void encoder_factory_field(benchmark::State& state)
+{
+    kslide_encoder_factory_t* factory = kslide_new_encoder_factory();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(kslide_encoder_factory_field(factory));
+    }
+    kslide_delete_encoder_factory(factory);
+}
+BENCHMARK(encoder_factory_field);
+
+static void encoder_factory_set_field(benchmark::State& state)
+{
+    kslide_encoder_factory_t* factory = kslide_new_encoder_factory();
+    for (auto _ : state)
+    {
+        kslide_encoder_factory_set_field(factory, kslide_binary8);
+    }
+    kslide_delete_encoder_factory(factory);
+}
+BENCHMARK(encoder_factory_set_field);
+
+static void encoder_factory_symbol_size(benchmark::State& state)
+{
+    kslide_encoder_factory_t* factory = kslide_new_encoder_factory();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(kslide_encoder_factory_symbol_size(factory));
+    }
+    kslide_delete_encoder_factory(factory);
+}
+BENCHMARK(encoder_factory_symbol_size);
+
+static void encoder_factory_build(benchmark::State& state)
+{
+    kslide_encoder_factory_t* factory = kslide_new_encoder_factory();
+    kslide_encoder_factory_set_symbol_size(factory, state.range(0));
+    for (auto _ : state)
+    {
+        kslide_delete_encoder(kslide_encoder_factory_build(factory));
+    }
+    kslide_delete_encoder_factory(factory);
+}
+BENCHMARK(encoder_factory_build)->Arg(tiny_symbol)->Arg(large_symbol);
+
+static void encoder_factory_initialize(benchmark::State& state)
+{
+    kslide_encoder_factory_t* factory = kslide_new_encoder_factory();
+    kslide_encoder_factory_set_symbol_size(factory, state.range(0));
+    kslide_encoder_t* encoder = kslide_encoder_factory_build(factory);
+    for (auto _ : state)
+    {
+        kslide_encoder_factory_initialize(factory, encoder);
+    }
+    kslide_delete_encoder(encoder);
+    kslide_delete_encoder_factory(factory);
+}
+BENCHMARK(encoder_factory_initialize)->Arg(tiny_symbol)->Arg(large_symbol);
+
+static void decoder_factory_field(benchmark::State& state)
+{
+    kslide_decoder_factory_t* factory = kslide_new_decoder_factory();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(kslide_decoder_factory_field(factory));
+    }
+    kslide_delete_decoder_factory(factory);
+}
+BENCHMARK(decoder_factory_field);
+
+static void decoder_factory_set_field(benchmark::State& state)
+{
+    kslide_decoder_factory_t* factory = kslide_new_decoder_factory();
+    for (auto _ : state)
+    {
+        kslide_decoder_factory_set_field(factory, kslide_binary8);
+    }
+    kslide_delete_decoder_factory(factory);
+}
+BENCHMARK(decoder_factory_set_field);
+
+static void decoder_factory_symbol_size(benchmark::State& state)
+{
+    kslide_decoder_factory_t* factory = kslide_new_decoder_factory();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(kslide_decoder_factory_symbol_size(factory));
+    }
+    kslide_delete_decoder_factory(factory);
+}
+BENCHMARK(decoder_factory_symbol_size);
+
+static void decoder_factory_build(benchmark::State& state)
+{
+    kslide_decoder_factory_t* factory = kslide_new_decoder_factory();
+    kslide_decoder_factory_set_symbol_size(factory, state.range(0));
+    for (auto _ : state)
+    {
+        kslide_delete_decoder(kslide_decoder_factory_build(factory));
+    }
+    kslide_delete_decoder_factory(factory);
+}
+BENCHMARK(decoder_factory_build)->Arg(tiny_symbol)->Arg(large_symbol);
+
+static void decoder_factory_initialize(benchmark::State& state)
+{
+    kslide_decoder_factory_t* factory = kslide_new_decoder_factory();
+    kslide_decoder_factory_set_symbol_size(factory, state.range(0));
+    kslide_decoder_t* decoder = kslide_decoder_factory_build(factory);
+    for (auto _ : state)
+    {
+        kslide_decoder_factory_initialize(factory, decoder);
+    }
+    kslide_delete_decoder(decoder);
+    kslide_delete_decoder_factory(factory);
+}
+BENCHMARK(decoder_factory_initialize)->Arg(tiny_symbol)->Arg(large_symbol);
+
+//------------------------------------------------------------------
+// ENCODER API
+//------------------------------------------------------------------
+
+static void encoder_queries(benchmark::State& state)
+{
+    coders c(kslide_binary8, tiny_symbol);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(kslide_encoder_symbol_size(c.m_encoder));
+        benchmark::DoNotOptimize(kslide_encoder_stream_symbols(c.m_encoder));
+        benchmark::DoNotOptimize(kslide_encoder_stream_lower_bound(c.m_encoder));
+        benchmark::DoNotOptimize(kslide_encoder_stream_upper_bound(c.m_encoder));
+        benchmark::DoNotOptimize(kslide_encoder_window_symbols(c.m_encoder));
+        benchmark::DoNotOptimize(kslide_encoder_window_lower_bound(c.m_encoder));
+        benchmark::DoNotOptimize(kslide_encoder_window_upper_bound(c.m_encoder));
+    }
+    state.SetItemsProcessed(state.iterations() * 7);
+}
+BENCHMARK(encoder_queries);
+
+static void encoder_push_pop_symbol(benchmark::State& state)
+{
+    coders c(kslide_binary8, state.range(0));
+    for (auto _ : state)
+    {
+        kslide_encoder_push_front_symbol(c.m_encoder, c.m_symbol.data());
+        kslide_encoder_pop_back_symbol(c.m_encoder);
+    }
+}
+BENCHMARK(encoder_push_pop_symbol)->Arg(tiny_symbol)->Arg(large_symbol);
+
+static void encoder_set_window(benchmark::State& state)
+{
+    coders c(kslide_binary8, tiny_symbol);
+    for (auto _ : state)
+    {
+        kslide_encoder_set_window(c.m_encoder, 0, window_symbols);
+    }
+}
+BENCHMARK(encoder_set_window);
+
+static void encoder_coefficient_vector_size(benchmark::State& state)
+{
+    coders c(kslide_binary8, tiny_symbol);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(
+            kslide_encoder_coefficient_vector_size(c.m_encoder));
+    }
+}
+BENCHMARK(encoder_coefficient_vector_size);
+
+static void encoder_set_seed(benchmark::State& state)
+{
+    coders c(kslide_binary8, tiny_symbol);
+    uint64_t seed = 0;
+    for (auto _ : state)
+    {
+        kslide_encoder_set_seed(c.m_encoder, ++seed);
+    }
+}
+BENCHMARK(encoder_set_seed);
+
+// The second argument selects the coefficient generator, so the default and
+// the counter based generator can be compared
+static void encoder_generate(benchmark::State& state)
+{
+    coders c(static_cast<int32_t>(state.range(0)), tiny_symbol,
+             static_cast<int32_t>(state.range(1)));
+    for (auto _ : state)
+    {
+        kslide_encoder_generate(c.m_encoder, c.m_coefficients.data());
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(encoder_generate)
+    ->ArgsProduct({benchmark::CreateDenseRange(kslide_binary, kslide_binary16, 1),
+                   {kslide_generator_default, kslide_generator_counter}});
+
+static void encoder_write_symbol(benchmark::State& state)
+{
+    coders c(static_cast<int32_t>(state.range(0)), state.range(1));
+    for (auto _ : state)
+    {
+        kslide_encoder_write_symbol(
+            c.m_encoder, c.m_symbol.data(), c.m_coefficients.data());
+        benchmark::ClobberMemory();
+    }
+    set_bytes_processed(state, state.range(1) * window_symbols);
+}
+BENCHMARK(encoder_write_symbol)
+    ->ArgsProduct({benchmark::CreateDenseRange(kslide_binary, kslide_binary16, 1),
+                   {tiny_symbol, large_symbol}});
+
+static void encoder_write_source_symbol(benchmark::State& state)
+{
+    coders c(kslide_binary8, state.range(0));
+    for (auto _ : state)
+    {
+        kslide_encoder_write_source_symbol(c.m_encoder, c.m_symbol.data(), 0);
+        benchmark::ClobberMemory();
+    }
+    set_bytes_processed(state, state.range(0));
+}
+BENCHMARK(encoder_write_source_symbol)->Arg(tiny_symbol)->Arg(large_symbol);
+
+//------------------------------------------------------------------
+// DECODER API
+//------------------------------------------------------------------
+
+static void decoder_queries(benchmark::State& state)
+{
+    coders c(kslide_binary8, tiny_symbol);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(kslide_decoder_symbol_size(c.m_decoder));
+        benchmark::DoNotOptimize(kslide_decoder_stream_symbols(c.m_decoder));
+        benchmark::DoNotOptimize(kslide_decoder_stream_lower_bound(c.m_decoder));
+        benchmark::DoNotOptimize(kslide_decoder_stream_upper_bound(c.m_decoder));
+        benchmark::DoNotOptimize(kslide_decoder_window_symbols(c.m_decoder));
+        benchmark::DoNotOptimize(kslide_decoder_window_lower_bound(c.m_decoder));
+        benchmark::DoNotOptimize(kslide_decoder_window_upper_bound(c.m_decoder));
+    }
+    state.SetItemsProcessed(state.iterations() * 7);
+}
+BENCHMARK(decoder_queries);
+
+static void decoder_state_queries(benchmark::State& state)
+{
+    coders c(kslide_binary8, tiny_symbol);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(kslide_decoder_rank(c.m_decoder));
+        benchmark::DoNotOptimize(kslide_decoder_symbols_missing(c.m_decoder));
+        benchmark::DoNotOptimize(
+            kslide_decoder_symbols_partially_decoded(c.m_decoder));
+        benchmark::DoNotOptimize(kslide_decoder_symbols_decoded(c.m_decoder));
+        benchmark::DoNotOptimize(kslide_decoder_is_symbol_decoded(c.m_decoder, 0));
+    }
+    state.SetItemsProcessed(state.iterations() * 5);
+}
+BENCHMARK(decoder_state_queries);
+
+static void decoder_push_pop_symbol(benchmark::State& state)
+{
+    coders c(kslide_binary8, state.range(0));
+    for (auto _ : state)
+    {
+        kslide_decoder_push_front_symbol(c.m_decoder, c.m_symbol.data());
+        kslide_decoder_pop_back_symbol(c.m_decoder);
+    }
+}
+BENCHMARK(decoder_push_pop_symbol)->Arg(tiny_symbol)->Arg(large_symbol);
+
+static void decoder_set_window(benchmark::State& state)
+{
+    coders c(kslide_binary8, tiny_symbol);
+    for (auto _ : state)
+    {
+        kslide_decoder_set_window(c.m_decoder, 0, window_symbols);
+    }
+}
+BENCHMARK(decoder_set_window);
+
+static void decoder_generate(benchmark::State& state)
+{
+    coders c(static_cast<int32_t>(state.range(0)), tiny_symbol);
+    for (auto _ : state)
+    {
+        kslide_decoder_generate(c.m_decoder, c.m_coefficients.data());
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(decoder_generate)->DenseRange(kslide_binary, kslide_binary16);
+
+// Decode a full window. Measures the complete decoding cost per symbol
+// including the elimination.
+static void decoder_read_symbol(benchmark::State& state)
+{
+    uint64_t symbol_size = state.range(1);
+    coders c(static_cast<int32_t>(state.range(0)), symbol_size);
+
+    std::vector<uint8_t> symbols(window_symbols * symbol_size * 2);
+    std::vector<uint8_t> coefficients(
+        window_symbols * 2 * c.m_coefficients.size());
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        kslide_decoder_factory_initialize(c.m_decoder_factory, c.m_decoder);
+        for (uint64_t i = 0; i < window_symbols; ++i)
+        {
+            kslide_decoder_push_front_symbol(
+                c.m_decoder, c.m_decoder_storage.data() + i * symbol_size);
+        }
+        kslide_decoder_set_window(c.m_decoder, 0, window_symbols);
+
+        uint64_t size = c.m_coefficients.size();
+        for (uint64_t i = 0; i < window_symbols * 2; ++i)
+        {
+            kslide_encoder_set_seed(c.m_encoder, i);
+            kslide_encoder_generate(c.m_encoder, &coefficients[i * size]);
+            kslide_encoder_write_symbol(
+                c.m_encoder, &symbols[i * symbol_size], &coefficients[i * size]);
+        }
+        state.ResumeTiming();
+
+        for (uint64_t i = 0; i < window_symbols * 2; ++i)
+        {
+            if (kslide_decoder_rank(c.m_decoder) == window_symbols)
+                break;
+
+            kslide_decoder_read_symbol(
+                c.m_decoder, &symbols[i * symbol_size], &coefficients[i * size]);
+        }
+    }
+    set_bytes_processed(state, window_symbols * symbol_size);
+}
+BENCHMARK(decoder_read_symbol)
+    ->ArgsProduct({benchmark::CreateDenseRange(kslide_binary, kslide_binary16, 1),
+                   {tiny_symbol, large_symbol}});
+
+static void decoder_read_source_symbol(benchmark::State& state)
+{
+    coders c(kslide_binary8, state.range(0));
+    for (auto _ : state)
+    {
+        kslide_decoder_read_source_symbol(c.m_decoder, c.m_symbol.data(), 0);
+        benchmark::ClobberMemory();
+    }
+    set_bytes_processed(state, state.range(0));
+}
+BENCHMARK(decoder_read_source_symbol)->Arg(tiny_symbol)->Arg(large_symbol);
+
+static void decoder_snapshot(benchmark::State& state)
+{
+    coders c(kslide_binary8, state.range(0));
+    for (uint64_t i = 0; i < window_symbols; ++i)
+    {
+        kslide_decoder_read_source_symbol(
+            c.m_decoder, c.m_encoder_storage.data() + i * state.range(0), i);
+    }
+
+    std::vector<uint8_t> snapshot(kslide_decoder_snapshot_size(c.m_decoder));
+    for (auto _ : state)
+    {
+        kslide_decoder_snapshot(c.m_decoder, snapshot.data());
+        benchmark::ClobberMemory();
+    }
+    set_bytes_processed(state, snapshot.size());
+}
+BENCHMARK(decoder_snapshot)->Arg(tiny_symbol)->Arg(large_symbol);
+
+BENCHMARK_MAIN();
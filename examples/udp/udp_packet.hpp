@@ -0,0 +1,95 @@
+// Copyright Steinwurf ApS 2018.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+// The packet format and helpers shared by the udp_sender and udp_receiver
+// examples. Every datagram has the same size: a fixed header followed by a
+// symbol. The fields are stored in the native byte order since both
+// examples run on the same host.
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include <sys/resource.h>
+#include <sys/time.h>
+
+enum packet_type : uint8_t
+{
+    packet_source = 0,
+    packet_coded = 1,
+    packet_end = 2
+};
+
+struct packet_header
+{
+    uint8_t m_type;
+
+    /// The source symbol index or the window lower bound of a coded symbol
+    uint64_t m_index;
+
+    /// The window symbols of a coded symbol
+    uint64_t m_window_symbols;
+
+    /// The seed used to generate the coefficients of a coded symbol
+    uint64_t m_seed;
+};
+
+const uint64_t header_size = 1 + 3 * sizeof(uint64_t);
+
+inline void write_header(uint8_t* buffer, const packet_header& header)
+{
+    buffer[0] = header.m_type;
+    memcpy(buffer + 1, &header.m_index, sizeof(uint64_t));
+    memcpy(buffer + 9, &header.m_window_symbols, sizeof(uint64_t));
+    memcpy(buffer + 17, &header.m_seed, sizeof(uint64_t));
+}
+
+inline packet_header read_header(const uint8_t* buffer)
+{
+    packet_header header;
+    header.m_type = buffer[0];
+    memcpy(&header.m_index, buffer + 1, sizeof(uint64_t));
+    memcpy(&header.m_window_symbols, buffer + 9, sizeof(uint64_t));
+    memcpy(&header.m_seed, buffer + 17, sizeof(uint64_t));
+    return header;
+}
+
+/// @return The wall clock time in seconds
+inline double wall_time()
+{
+    struct timeval now;
+    gettimeofday(&now, nullptr);
+    return now.tv_sec + now.tv_usec / 1e6;
+}
+
+/// @return The CPU time (user and system) used by the process in seconds
+inline double cpu_time()
+{
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_utime.tv_sec + usage.ru_utime.tv_usec / 1e6 +
+           usage.ru_stime.tv_sec + usage.ru_stime.tv_usec / 1e6;
+}
+
+/// Parse an option of the form --name=value
+/// @return true if the argument matched the option name
+inline bool parse_option(const char* argument, const char* name,
+                         std::string& value)
+{
+    size_t length = strlen(name);
+    if (strncmp(argument, "--", 2) != 0 ||
+        strncmp(argument + 2, name, length) != 0 ||
+        argument[2 + length] != '=')
+    {
+        return false;
+    }
+
+    value = argument + 3 + length;
+    return true;
+}
@@ -0,0 +1,257 @@
+// Copyright Steinwurf ApS 2018.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+// Receives the stream sent by the udp_sender example and decodes it. The
+// datagrams are received in batches with recvmmsg(), and with --gro=1 the
+// kernel may coalesce several datagrams into each received buffer (UDP
+// GRO). The receiver stops at the end of the stream or after one second
+// without packets.
+//
+// Usage:
+//
+//     udp_receiver [--port=7000] [--symbol_size=1300] [--capacity=64]
+//                  [--batch=32] [--gro=0]
+
+#include <kodo_slide_c/kodo_slide_c.h>
+
+#include "udp_packet.hpp"
+
+#include <vector>
+
+#include <netinet/in.h>
+#include <netinet/udp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#ifndef UDP_GRO
+#define UDP_GRO 104
+#endif
+
+int main(int argc, char* argv[])
+{
+    uint16_t port = 7000;
+    uint64_t symbol_size = 1300;
+    uint64_t capacity = 64;
+    uint32_t batch = 32;
+    bool gro = false;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string value;
+        if (parse_option(argv[i], "port", value)) port = std::stoul(value);
+        else if (parse_option(argv[i], "symbol_size", value)) symbol_size = std::stoull(value);
+        else if (parse_option(argv[i], "capacity", value)) capacity = std::stoull(value);
+        else if (parse_option(argv[i], "batch", value)) batch = std::stoul(value);
+        else if (parse_option(argv[i], "gro", value)) gro = std::stoul(value) != 0;
+        else
+        {
+            printf("Unknown option: %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    int sock = socket(AF_INET, SOCK_DGRAM, 0);
+    if (sock < 0)
+    {
+        perror("socket");
+        return 1;
+    }
+
+    int buffer_size = 16 * 1024 * 1024;
+    setsockopt(sock, SOL_SOCKET, SO_RCVBUF, &buffer_size, sizeof(buffer_size));
+
+    timeval timeout = {1, 0};
+    setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    if (gro)
+    {
+        int enable = 1;
+        if (setsockopt(sock, SOL_UDP, UDP_GRO, &enable, sizeof(enable)) != 0)
+        {
+            perror("UDP_GRO");
+            return 1;
+        }
+    }
+
+    sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    if (bind(sock, (sockaddr*) &address, sizeof(address)) != 0)
+    {
+        perror("bind");
+        return 1;
+    }
+
+    kslide_decoder_factory_t* factory = kslide_new_decoder_factory();
+    kslide_decoder_factory_set_symbol_size(factory, symbol_size);
+    kslide_decoder_t* decoder = kslide_decoder_factory_build(factory);
+
+    std::vector<uint8_t> storage(capacity * symbol_size);
+    for (uint64_t i = 0; i < capacity; ++i)
+    {
+        kslide_decoder_push_front_symbol(decoder, &storage[i * symbol_size]);
+    }
+
+    // With GRO a buffer may hold up to 64 KiB of coalesced datagrams
+    uint64_t packet_size = header_size + symbol_size;
+    uint64_t buffer_capacity = gro ? 65536 : packet_size;
+
+    std::vector<uint8_t> buffers(batch * buffer_capacity);
+    std::vector<iovec> vectors(batch);
+    std::vector<mmsghdr> messages(batch);
+    std::vector<uint8_t> controls(batch * CMSG_SPACE(sizeof(uint16_t)));
+    std::vector<uint8_t> coefficients;
+
+    uint64_t received = 0;
+    uint64_t decoded = 0;
+    uint64_t symbols = 0;
+    bool end = false;
+
+    // Count the decoded symbols as they leave the decoder's stream
+    auto pop_symbol = [&]()
+    {
+        uint64_t index = kslide_decoder_stream_lower_bound(decoder);
+        decoded += kslide_decoder_is_symbol_decoded(decoder, index);
+        kslide_decoder_pop_back_symbol(decoder);
+        return index;
+    };
+
+    auto handle_packet = [&](uint8_t* packet)
+    {
+        packet_header header = read_header(packet);
+        uint8_t* symbol = packet + header_size;
+
+        if (header.m_type == packet_end)
+        {
+            symbols = header.m_index;
+            end = true;
+            return;
+        }
+
+        ++received;
+
+        uint64_t upper_bound = header.m_type == packet_source
+                               ? header.m_index + 1
+                               : header.m_index + header.m_window_symbols;
+
+        // Slide the stream, reusing the storage of the popped symbols
+        while (kslide_decoder_stream_upper_bound(decoder) < upper_bound)
+        {
+            uint64_t index = pop_symbol();
+            kslide_decoder_push_front_symbol(
+                decoder, &storage[(index % capacity) * symbol_size]);
+        }
+
+        if (header.m_type == packet_source)
+        {
+            if (header.m_index >= kslide_decoder_stream_lower_bound(decoder))
+                kslide_decoder_read_source_symbol(decoder, symbol, header.m_index);
+            return;
+        }
+
+        if (header.m_index < kslide_decoder_stream_lower_bound(decoder))
+            return;
+
+        kslide_decoder_set_window(decoder, header.m_index,
+                                  header.m_window_symbols);
+        coefficients.resize(kslide_decoder_coefficient_vector_size(decoder));
+        kslide_decoder_set_seed(decoder, header.m_seed);
+        kslide_decoder_generate(decoder, coefficients.data());
+        kslide_decoder_read_symbol(decoder, symbol, coefficients.data());
+    };
+
+    double start_wall = 0;
+    double start_cpu = 0;
+    double last_packet = 0;
+
+    while (!end)
+    {
+        for (uint32_t i = 0; i < batch; ++i)
+        {
+            vectors[i].iov_base = &buffers[i * buffer_capacity];
+            vectors[i].iov_len = buffer_capacity;
+            memset(&messages[i], 0, sizeof(mmsghdr));
+            messages[i].msg_hdr.msg_iov = &vectors[i];
+            messages[i].msg_hdr.msg_iovlen = 1;
+            messages[i].msg_hdr.msg_control =
+                &controls[i * CMSG_SPACE(sizeof(uint16_t))];
+            messages[i].msg_hdr.msg_controllen = CMSG_SPACE(sizeof(uint16_t));
+        }
+
+        int count = recvmmsg(sock, messages.data(), batch, MSG_WAITFORONE,
+                             nullptr);
+        if (count < 0)
+        {
+            // Timeout: give up if the stream has started
+            if (start_wall > 0)
+                break;
+
+            continue;
+        }
+
+        if (start_wall == 0)
+        {
+            start_wall = wall_time();
+            start_cpu = cpu_time();
+        }
+
+        for (int i = 0; i < count; ++i)
+        {
+            uint8_t* buffer = &buffers[i * buffer_capacity];
+            uint64_t length = messages[i].msg_len;
+            uint64_t segment = packet_size;
+
+            // With GRO the segment size is reported in a control message
+            msghdr& header = messages[i].msg_hdr;
+            for (cmsghdr* c = CMSG_FIRSTHDR(&header); c != nullptr;
+                 c = CMSG_NXTHDR(&header, c))
+            {
+                if (c->cmsg_level == SOL_UDP && c->cmsg_type == UDP_GRO)
+                {
+                    uint16_t size;
+                    memcpy(&size, CMSG_DATA(c), sizeof(size));
+                    segment = size;
+                }
+            }
+
+            for (uint64_t offset = 0; offset + segment <= length;
+                 offset += segment)
+            {
+                if (segment == packet_size)
+                    handle_packet(buffer + offset);
+            }
+        }
+
+        last_packet = wall_time();
+    }
+
+    // Count the symbols remaining in the stream
+    while (kslide_decoder_stream_symbols(decoder) > 0 &&
+           kslide_decoder_stream_lower_bound(decoder) <
+           (symbols > 0 ? symbols : kslide_decoder_stream_upper_bound(decoder)))
+    {
+        pop_symbol();
+    }
+
+    double elapsed = last_packet - start_wall;
+    double cpu = cpu_time() - start_cpu;
+
+    printf("packets_received: %llu\n", (unsigned long long) received);
+    printf("symbols: %llu\n", (unsigned long long) symbols);
+    printf("symbols_decoded: %llu\n", (unsigned long long) decoded);
+    printf("elapsed_s: %.3f\n", elapsed);
+    printf("goodput_mbps: %.1f\n",
+           elapsed > 0 ? decoded * symbol_size * 8 / elapsed / 1e6 : 0.0);
+    printf("cpu_s: %.3f\n", cpu);
+    printf("cpu_ns_per_byte: %.3f\n",
+           decoded > 0 ? cpu * 1e9 / (double) (decoded * symbol_size) : 0.0);
+
+    kslide_delete_decoder(decoder);
+    kslide_delete_decoder_factory(factory);
+    close(sock);
+    return 0;
+}
@@ -0,0 +1,276 @@
+// Copyright Steinwurf ApS 2018.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+// Sends a stream of random source symbols and repair symbols to the
+// udp_receiver example over UDP. The packets are sent in batches with
+// sendmmsg(), or as a single UDP GSO super-packet per batch with --gso=1.
+// Losses are simulated by dropping packets at random before they are sent.
+//
+// Usage:
+//
+//     udp_sender [--host=127.0.0.1] [--port=7000] [--symbols=100000]
+//                [--symbol_size=1300] [--window=32] [--rate_n=6]
+//                [--rate_k=5] [--loss=0.05] [--batch=32] [--gso=0]
+//                [--mbps=0] [--seed=0]
+
+#include <kodo_slide_c/kodo_slide_c.h>
+
+#include "udp_packet.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/udp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT 103
+#endif
+
+int main(int argc, char* argv[])
+{
+    std::string host = "127.0.0.1";
+    uint16_t port = 7000;
+    uint64_t symbols = 100000;
+    uint64_t symbol_size = 1300;
+    uint64_t window = 32;
+    uint32_t rate_n = 6;
+    uint32_t rate_k = 5;
+    double loss = 0.05;
+    uint32_t batch = 32;
+    bool gso = false;
+    double mbps = 0;
+    uint64_t seed = 0;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string value;
+        if (parse_option(argv[i], "host", value)) host = value;
+        else if (parse_option(argv[i], "port", value)) port = std::stoul(value);
+        else if (parse_option(argv[i], "symbols", value)) symbols = std::stoull(value);
+        else if (parse_option(argv[i], "symbol_size", value)) symbol_size = std::stoull(value);
+        else if (parse_option(argv[i], "window", value)) window = std::stoull(value);
+        else if (parse_option(argv[i], "rate_n", value)) rate_n = std::stoul(value);
+        else if (parse_option(argv[i], "rate_k", value)) rate_k = std::stoul(value);
+        else if (parse_option(argv[i], "loss", value)) loss = std::stod(value);
+        else if (parse_option(argv[i], "batch", value)) batch = std::stoul(value);
+        else if (parse_option(argv[i], "gso", value)) gso = std::stoul(value) != 0;
+        else if (parse_option(argv[i], "mbps", value)) mbps = std::stod(value);
+        else if (parse_option(argv[i], "seed", value)) seed = std::stoull(value);
+        else
+        {
+            printf("Unknown option: %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    if (rate_k == 0 || rate_k > rate_n || window == 0 || batch == 0)
+    {
+        printf("Invalid configuration\n");
+        return 1;
+    }
+
+    int sock = socket(AF_INET, SOCK_DGRAM, 0);
+    if (sock < 0)
+    {
+        perror("socket");
+        return 1;
+    }
+
+    sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    if (inet_pton(AF_INET, host.c_str(), &address.sin_addr) != 1 ||
+        connect(sock, (sockaddr*) &address, sizeof(address)) != 0)
+    {
+        perror("connect");
+        return 1;
+    }
+
+    uint64_t packet_size = header_size + symbol_size;
+    if (gso)
+    {
+        int segment = packet_size;
+        if (setsockopt(sock, SOL_UDP, UDP_SEGMENT, &segment,
+                       sizeof(segment)) != 0)
+        {
+            perror("UDP_SEGMENT");
+            return 1;
+        }
+
+        // A GSO super-packet is limited to 64 KiB
+        batch = std::min<uint64_t>(batch, 65000 / packet_size);
+    }
+
+    kslide_encoder_factory_t* factory = kslide_new_encoder_factory();
+    kslide_encoder_factory_set_symbol_size(factory, symbol_size);
+    kslide_encoder_t* encoder = kslide_encoder_factory_build(factory);
+    kslide_encoder_set_track_stream(encoder, 1);
+
+    std::vector<uint8_t> storage(window * symbol_size);
+    std::vector<uint8_t> coefficients;
+    std::vector<uint8_t> packets(batch * packet_size);
+    std::vector<iovec> vectors(batch);
+    std::vector<mmsghdr> messages(batch);
+
+    std::mt19937_64 random(seed);
+    std::uniform_real_distribution<double> distribution(0.0, 1.0);
+
+    uint64_t sent = 0;
+    uint64_t dropped = 0;
+    uint32_t position = 0;
+    bool end = false;
+
+    double start_wall = wall_time();
+    double start_cpu = cpu_time();
+
+    while (!end)
+    {
+        // Fill a batch of packets
+        uint32_t count = 0;
+        while (count < batch && !end)
+        {
+            uint8_t* packet = &packets[count * packet_size];
+            packet_header header;
+            memset(&header, 0, sizeof(header));
+
+            bool more = kslide_encoder_stream_upper_bound(encoder) < symbols;
+
+            if (position < rate_k && more)
+            {
+                if (kslide_encoder_stream_symbols(encoder) == window)
+                    kslide_encoder_pop_back_symbol(encoder);
+
+                uint64_t index = kslide_encoder_stream_upper_bound(encoder);
+                uint8_t* symbol = &storage[(index % window) * symbol_size];
+                for (uint64_t i = 0; i < symbol_size; ++i)
+                    symbol[i] = static_cast<uint8_t>(random());
+
+                kslide_encoder_push_front_symbol(encoder, symbol);
+                kslide_encoder_write_source_symbol(
+                    encoder, packet + header_size, index);
+
+                header.m_type = packet_source;
+                header.m_index = index;
+            }
+            else if (position >= rate_k)
+            {
+                coefficients.resize(
+                    kslide_encoder_coefficient_vector_size(encoder));
+                header.m_type = packet_coded;
+                header.m_index = kslide_encoder_window_lower_bound(encoder);
+                header.m_window_symbols = kslide_encoder_window_symbols(encoder);
+                header.m_seed = sent;
+
+                kslide_encoder_set_seed(encoder, header.m_seed);
+                kslide_encoder_generate(encoder, coefficients.data());
+                kslide_encoder_write_symbol(
+                    encoder, packet + header_size, coefficients.data());
+            }
+            else
+            {
+                // All source symbols are sent and the rate period completed
+                end = true;
+                break;
+            }
+
+            position = (position + 1) % rate_n;
+            ++sent;
+
+            if (distribution(random) < loss)
+            {
+                ++dropped;
+                continue;
+            }
+
+            write_header(packet, header);
+            ++count;
+        }
+
+        if (count == 0)
+            continue;
+
+        int result;
+        if (gso)
+        {
+            // One super-packet which the kernel splits into the datagrams
+            vectors[0].iov_base = packets.data();
+            vectors[0].iov_len = count * packet_size;
+
+            msghdr message;
+            memset(&message, 0, sizeof(message));
+            message.msg_iov = vectors.data();
+            message.msg_iovlen = 1;
+            result = sendmsg(sock, &message, 0) < 0 ? -1 : (int) count;
+        }
+        else
+        {
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                vectors[i].iov_base = &packets[i * packet_size];
+                vectors[i].iov_len = packet_size;
+                memset(&messages[i], 0, sizeof(mmsghdr));
+                messages[i].msg_hdr.msg_iov = &vectors[i];
+                messages[i].msg_hdr.msg_iovlen = 1;
+            }
+
+            result = sendmmsg(sock, messages.data(), count, 0);
+        }
+
+        if (result < 0)
+        {
+            perror("send");
+            return 1;
+        }
+
+        // Pace the sender if a rate is configured
+        if (mbps > 0)
+        {
+            double target = start_wall + (sent * packet_size * 8) / (mbps * 1e6);
+            double now = wall_time();
+            if (target > now)
+            {
+                std::this_thread::sleep_for(
+                    std::chrono::microseconds((int64_t) ((target - now) * 1e6)));
+            }
+        }
+    }
+
+    // Signal the end of the stream. Sent a few times in case of losses.
+    std::vector<uint8_t> end_packet(packet_size, 0);
+    packet_header header;
+    memset(&header, 0, sizeof(header));
+    header.m_type = packet_end;
+    header.m_index = symbols;
+    write_header(end_packet.data(), header);
+    for (uint32_t i = 0; i < 5; ++i)
+    {
+        send(sock, end_packet.data(), packet_size, 0);
+    }
+
+    double elapsed = wall_time() - start_wall;
+    double cpu = cpu_time() - start_cpu;
+
+    printf("packets_sent: %llu\n", (unsigned long long) (sent - dropped));
+    printf("packets_dropped: %llu\n", (unsigned long long) dropped);
+    printf("elapsed_s: %.3f\n", elapsed);
+    printf("throughput_mbps: %.1f\n",
+           (sent - dropped) * packet_size * 8 / elapsed / 1e6);
+    printf("cpu_s: %.3f\n", cpu);
+    printf("cpu_ns_per_byte: %.3f\n",
+           cpu * 1e9 / (double) (symbols * symbol_size));
+
+    kslide_delete_encoder(encoder);
+    kslide_delete_encoder_factory(factory);
+    close(sock);
+    return 0;
+}
@@ -0,0 +1,437 @@
+// Copyright Steinwurf ApS 2018.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+// Deterministic loss simulator driving an encoder and a decoder through the
+// C API. The encoder sends the source symbols systematically and adds
+// repair symbols according to a rate of n packets per k source symbols. The
+// packets are passed through a loss model and the decoder reports the
+// goodput, the decoding delay distribution, the overhead and the CPU time
+// spent per decoded byte. The same seed always produces the same result.
+//
+// Usage:
+//
+//     kodo_slide_c_simulator [--option=value ...]
+//
+// See print_usage() for the available options.
+
+#include <kodo_slide_c/kodo_slide_c.h>
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+/// The loss models supported by the channel
+enum class loss_model
+{
+    none,
+    iid,
+    burst,
+    gilbert_elliott
+};
+
+struct config
+{
+    uint64_t m_symbols = 10000;
+    uint64_t m_symbol_size = 1300;
+    int32_t m_field = kslide_binary8;
+    uint64_t m_window_symbols = 32;
+    uint64_t m_decoder_capacity = 64;
+    uint32_t m_rate_n = 6;
+    uint32_t m_rate_k = 5;
+    uint64_t m_seed = 0;
+
+    loss_model m_loss_model = loss_model::iid;
+
+    // i.i.d: each packet is lost with this probability
+    double m_loss_rate = 0.05;
+
+    // burst: a burst of m_burst_length losses starts with probability
+    // m_burst_rate at each packet
+    double m_burst_rate = 0.01;
+    uint32_t m_burst_length = 5;
+
+    // Gilbert-Elliott: transition probabilities between the good and the
+    // bad state and the loss probabilities in each state
+    double m_ge_good_to_bad = 0.01;
+    double m_ge_bad_to_good = 0.3;
+    double m_ge_good_loss = 0.001;
+    double m_ge_bad_loss = 0.5;
+};
+
+/// Deterministic packet erasure channel
+class channel
+{
+public:
+    channel(const config& c) :
+        m_config(c),
+        m_random(c.m_seed)
+    { }
+
+    /// @return true if the next packet is lost
+    bool lose_packet()
+    {
+        switch (m_config.m_loss_model)
+        {
+        case loss_model::none:
+            return false;
+        case loss_model::iid:
+            return draw(m_config.m_loss_rate);
+        case loss_model::burst:
+            if (m_burst_remaining == 0 && draw(m_config.m_burst_rate))
+            {
+                m_burst_remaining = m_config.m_burst_length;
+            }
+            if (m_burst_remaining > 0)
+            {
+                --m_burst_remaining;
+                return true;
+            }
+            return false;
+        case loss_model::gilbert_elliott:
+            if (m_bad_state)
+            {
+                m_bad_state = !draw(m_config.m_ge_bad_to_good);
+            }
+            else
+            {
+                m_bad_state = draw(m_config.m_ge_good_to_bad);
+            }
+            return draw(m_bad_state ? m_config.m_ge_bad_loss
+                                    : m_config.m_ge_good_loss);
+        }
+        assert(false && "Unknown loss model");
+        return false;
+    }
+
+private:
+    bool draw(double probability)
+    {
+        return m_distribution(m_random) < probability;
+    }
+
+private:
+    const config& m_config;
+    std::mt19937_64 m_random;
+    std::uniform_real_distribution<double> m_distribution{0.0, 1.0};
+    uint32_t m_burst_remaining = 0;
+    bool m_bad_state = false;
+};
+
+/// A packet on the simulated wire
+struct packet
+{
+    bool m_systematic;
+    uint64_t m_index;
+    uint64_t m_window_lower_bound;
+    uint64_t m_window_symbols;
+    uint64_t m_seed;
+    std::vector<uint8_t> m_symbol;
+};
+
+struct result
+{
+    uint64_t m_packets_sent = 0;
+    uint64_t m_packets_received = 0;
+    uint64_t m_symbols_decoded = 0;
+
+    // Delay from the packet carrying a source symbol was sent until the
+    // symbol was decoded, measured in packets sent. A symbol received
+    // directly has a delay of 0.
+    std::vector<uint64_t> m_delays;
+
+    // Time spent in the decoder calls
+    std::chrono::nanoseconds m_decoder_time{0};
+};
+
+void run(const config& c, result& r)
+{
+    kslide_encoder_factory_t* encoder_factory = kslide_new_encoder_factory();
+    kslide_decoder_factory_t* decoder_factory = kslide_new_decoder_factory();
+
+    kslide_encoder_factory_set_field(encoder_factory, c.m_field);
+    kslide_decoder_factory_set_field(decoder_factory, c.m_field);
+    kslide_encoder_factory_set_symbol_size(encoder_factory, c.m_symbol_size);
+    kslide_decoder_factory_set_symbol_size(decoder_factory, c.m_symbol_size);
+
+    kslide_encoder_t* encoder = kslide_encoder_factory_build(encoder_factory);
+    kslide_decoder_t* decoder = kslide_decoder_factory_build(decoder_factory);
+
+    // The encoder only needs the symbols in its window, the decoder's
+    // storage is a ring buffer of the decoder's capacity
+    std::vector<uint8_t> encoder_storage(c.m_window_symbols * c.m_symbol_size);
+    std::vector<uint8_t> decoder_storage(
+        c.m_decoder_capacity * c.m_symbol_size);
+
+    auto decoder_symbol = [&](uint64_t index)
+    {
+        return decoder_storage.data() +
+               (index % c.m_decoder_capacity) * c.m_symbol_size;
+    };
+
+    for (uint64_t i = 0; i < c.m_decoder_capacity; ++i)
+    {
+        kslide_decoder_push_front_symbol(decoder, decoder_symbol(i));
+    }
+
+    std::mt19937_64 data_random(c.m_seed + 1);
+    channel wire(c);
+
+    // The packet number at which each source symbol was first sent and
+    // whether it has been decoded
+    std::vector<uint64_t> sent_at(c.m_symbols);
+    std::vector<uint8_t> decoded(c.m_symbols, 0);
+
+    uint32_t position = 0;
+    packet p;
+    p.m_symbol.resize(c.m_symbol_size);
+    std::vector<uint8_t> coefficients;
+
+    auto collect_decoded = [&]()
+    {
+        uint64_t lower_bound = kslide_decoder_stream_lower_bound(decoder);
+        uint64_t upper_bound = std::min<uint64_t>(
+            kslide_decoder_stream_upper_bound(decoder), c.m_symbols);
+
+        for (uint64_t i = lower_bound; i < upper_bound; ++i)
+        {
+            if (decoded[i] || !kslide_decoder_is_symbol_decoded(decoder, i))
+                continue;
+
+            decoded[i] = 1;
+            ++r.m_symbols_decoded;
+            r.m_delays.push_back(r.m_packets_sent - 1 - sent_at[i]);
+        }
+    };
+
+    while (kslide_encoder_stream_upper_bound(encoder) < c.m_symbols ||
+           position != 0)
+    {
+        bool systematic = position < c.m_rate_k &&
+                          kslide_encoder_stream_upper_bound(encoder) <
+                          c.m_symbols;
+        position = (position + 1) % c.m_rate_n;
+
+        if (systematic)
+        {
+            if (kslide_encoder_stream_symbols(encoder) == c.m_window_symbols)
+            {
+                kslide_encoder_pop_back_symbol(encoder);
+            }
+
+            uint64_t index = kslide_encoder_stream_upper_bound(encoder);
+            uint8_t* symbol = encoder_storage.data() +
+                              (index % c.m_window_symbols) * c.m_symbol_size;
+            for (uint64_t i = 0; i < c.m_symbol_size; ++i)
+            {
+                symbol[i] = static_cast<uint8_t>(data_random());
+            }
+
+            kslide_encoder_push_front_symbol(encoder, symbol);
+            kslide_encoder_write_source_symbol(encoder, p.m_symbol.data(),
+                                               index);
+            sent_at[index] = r.m_packets_sent;
+            p.m_index = index;
+        }
+        else
+        {
+            if (kslide_encoder_stream_symbols(encoder) == 0)
+                continue;
+
+            kslide_encoder_set_window(
+                encoder, kslide_encoder_stream_lower_bound(encoder),
+                kslide_encoder_stream_symbols(encoder));
+
+            coefficients.resize(kslide_encoder_coefficient_vector_size(encoder));
+            p.m_seed = r.m_packets_sent;
+            kslide_encoder_set_seed(encoder, p.m_seed);
+            kslide_encoder_generate(encoder, coefficients.data());
+            kslide_encoder_write_symbol(encoder, p.m_symbol.data(),
+                                        coefficients.data());
+        }
+
+        p.m_systematic = systematic;
+        p.m_window_lower_bound = kslide_encoder_stream_lower_bound(encoder);
+        p.m_window_symbols = kslide_encoder_stream_symbols(encoder);
+        uint64_t stream_upper_bound = kslide_encoder_stream_upper_bound(encoder);
+
+        ++r.m_packets_sent;
+
+        if (wire.lose_packet())
+            continue;
+
+        ++r.m_packets_received;
+
+        auto start = std::chrono::steady_clock::now();
+
+        // Slide the decoder's stream to include the newest symbol
+        while (kslide_decoder_stream_upper_bound(decoder) < stream_upper_bound)
+        {
+            uint64_t index = kslide_decoder_pop_back_symbol(decoder);
+            kslide_decoder_push_front_symbol(decoder, decoder_symbol(index));
+        }
+
+        if (p.m_systematic)
+        {
+            kslide_decoder_read_source_symbol(decoder, p.m_symbol.data(),
+                                              p.m_index);
+        }
+        else
+        {
+            kslide_decoder_set_window(decoder, p.m_window_lower_bound,
+                                      p.m_window_symbols);
+            coefficients.resize(kslide_decoder_coefficient_vector_size(decoder));
+            kslide_decoder_set_seed(decoder, p.m_seed);
+            kslide_decoder_generate(decoder, coefficients.data());
+            kslide_decoder_read_symbol(decoder, p.m_symbol.data(),
+                                       coefficients.data());
+        }
+
+        r.m_decoder_time += std::chrono::steady_clock::now() - start;
+
+        collect_decoded();
+    }
+
+    kslide_delete_encoder(encoder);
+    kslide_delete_decoder(decoder);
+    kslide_delete_encoder_factory(encoder_factory);
+    kslide_delete_decoder_factory(decoder_factory);
+}
+
+uint64_t percentile(std::vector<uint64_t>& values, double fraction)
+{
+    if (values.empty())
+        return 0;
+
+    uint64_t index = static_cast<uint64_t>(fraction * (values.size() - 1));
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return values[index];
+}
+
+void print_result(const config& c, result& r)
+{
+    double decoded_bytes =
+        static_cast<double>(r.m_symbols_decoded) * c.m_symbol_size;
+
+    printf("packets_sent: %llu\n", (unsigned long long) r.m_packets_sent);
+    printf("packets_received: %llu\n",
+           (unsigned long long) r.m_packets_received);
+    printf("packet_loss: %.6f\n",
+           1.0 - (double) r.m_packets_received / r.m_packets_sent);
+    printf("symbols: %llu\n", (unsigned long long) c.m_symbols);
+    printf("symbols_decoded: %llu\n", (unsigned long long) r.m_symbols_decoded);
+    printf("residual_loss: %.6f\n",
+           1.0 - (double) r.m_symbols_decoded / c.m_symbols);
+    printf("goodput: %.6f\n", (double) r.m_symbols_decoded / r.m_packets_sent);
+    printf("overhead: %.6f\n", (double) r.m_packets_sent / c.m_symbols);
+    printf("delay_p50: %llu\n",
+           (unsigned long long) percentile(r.m_delays, 0.5));
+    printf("delay_p90: %llu\n",
+           (unsigned long long) percentile(r.m_delays, 0.9));
+    printf("delay_p99: %llu\n",
+           (unsigned long long) percentile(r.m_delays, 0.99));
+    printf("delay_max: %llu\n",
+           (unsigned long long) percentile(r.m_delays, 1.0));
+    printf("decoder_ns_per_byte: %.6f\n",
+           decoded_bytes > 0 ? r.m_decoder_time.count() / decoded_bytes : 0.0);
+}
+
+void print_usage(const char* program)
+{
+    printf("Usage: %s [--option=value ...]\n\n", program);
+    printf("  --symbols=N           source symbols to send (10000)\n");
+    printf("  --symbol_size=N       symbol size in bytes (1300)\n");
+    printf("  --field=F             binary, binary4, binary8, binary16\n");
+    printf("  --window=N            encoder window symbols (32)\n");
+    printf("  --capacity=N          decoder stream symbols (64)\n");
+    printf("  --rate_n=N            packets per rate period (6)\n");
+    printf("  --rate_k=N            source packets per rate period (5)\n");
+    printf("  --seed=N              seed of the simulation (0)\n");
+    printf("  --loss=M              none, iid, burst, ge (iid)\n");
+    printf("  --loss_rate=P         iid loss probability (0.05)\n");
+    printf("  --burst_rate=P        probability that a burst starts (0.01)\n");
+    printf("  --burst_length=N      packets lost per burst (5)\n");
+    printf("  --ge_good_to_bad=P    Gilbert-Elliott transition (0.01)\n");
+    printf("  --ge_bad_to_good=P    Gilbert-Elliott transition (0.3)\n");
+    printf("  --ge_good_loss=P      loss in the good state (0.001)\n");
+    printf("  --ge_bad_loss=P       loss in the bad state (0.5)\n");
+}
+
+bool parse_option(config& c, const std::string& name, const std::string& value)
+{
+    const std::map<std::string, int32_t> fields = {
+        {"binary", kslide_binary}, {"binary4", kslide_binary4},
+        {"binary8", kslide_binary8}, {"binary16", kslide_binary16}};
+
+    const std::map<std::string, loss_model> models = {
+        {"none", loss_model::none}, {"iid", loss_model::iid},
+        {"burst", loss_model::burst}, {"ge", loss_model::gilbert_elliott}};
+
+    if (name == "symbols") c.m_symbols = std::stoull(value);
+    else if (name == "symbol_size") c.m_symbol_size = std::stoull(value);
+    else if (name == "window") c.m_window_symbols = std::stoull(value);
+    else if (name == "capacity") c.m_decoder_capacity = std::stoull(value);
+    else if (name == "rate_n") c.m_rate_n = std::stoul(value);
+    else if (name == "rate_k") c.m_rate_k = std::stoul(value);
+    else if (name == "seed") c.m_seed = std::stoull(value);
+    else if (name == "loss_rate") c.m_loss_rate = std::stod(value);
+    else if (name == "burst_rate") c.m_burst_rate = std::stod(value);
+    else if (name == "burst_length") c.m_burst_length = std::stoul(value);
+    else if (name == "ge_good_to_bad") c.m_ge_good_to_bad = std::stod(value);
+    else if (name == "ge_bad_to_good") c.m_ge_bad_to_good = std::stod(value);
+    else if (name == "ge_good_loss") c.m_ge_good_loss = std::stod(value);
+    else if (name == "ge_bad_loss") c.m_ge_bad_loss = std::stod(value);
+    else if (name == "field" && fields.count(value))
+        c.m_field = fields.at(value);
+    else if (name == "loss" && models.count(value))
+        c.m_loss_model = models.at(value);
+    else
+        return false;
+
+    return true;
+}
+}
+
+int main(int argc, char* argv[])
+{
+    config c;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string argument = argv[i];
+        std::string::size_type separator = argument.find('=');
+
+        if (argument.compare(0, 2, "--") != 0 ||
+            separator == std::string::npos ||
+            !parse_option(c, argument.substr(2, separator - 2),
+                          argument.substr(separator + 1)))
+        {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (c.m_rate_k == 0 || c.m_rate_k > c.m_rate_n || c.m_window_symbols == 0 ||
+        c.m_decoder_capacity < c.m_window_symbols)
+    {
+        printf("Invalid configuration\n");
+        return 1;
+    }
+
+    result r;
+    run(c, r);
+    print_result(c, r);
+
+    return 0;
+}
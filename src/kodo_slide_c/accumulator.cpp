@@ -0,0 +1,169 @@
+// Copyright Steinwurf ApS 2018.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include "accumulator.hpp"
+#include "coefficient_codec.hpp"
+#include "kodo_slide_c.h"
+#include "wrappers.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+namespace kodo_slide_c
+{
+namespace
+{
+/// Returns the next coefficient for a running repair symbol. The binary
+/// field allows zero coefficients, since its only non-zero coefficient is 1
+/// and all repair symbols would otherwise be the same.
+uint16_t next_coefficient(kslide_encoder& encoder)
+{
+    uint32_t bits = field_bits(encoder.m_field);
+    uint32_t mask = (1U << bits) - 1;
+
+    while (true)
+    {
+        // splitmix64
+        uint64_t z = (encoder.m_accumulator_state += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        z = z ^ (z >> 31);
+
+        uint16_t value = static_cast<uint16_t>(z & mask);
+        if (value != 0 || bits == 1)
+            return value;
+    }
+}
+
+/// Adds the symbol at index times its coefficients to each running repair
+/// symbol. The coefficients are stored from offset in the coefficients of
+/// the encoder. Addition is xor in the binary extension fields, so adding
+/// the same product twice removes it again.
+void accumulate(kslide_encoder& encoder, uint64_t index, uint64_t offset)
+{
+    kodo_slide::encoder& impl = encoder.m_impl;
+    uint64_t symbol_size = impl.symbol_size();
+    uint32_t bits = field_bits(encoder.m_field);
+
+    uint64_t window_lower_bound = impl.window_lower_bound();
+    uint64_t window_symbols = impl.window_symbols();
+    impl.set_window(index, 1);
+
+    uint8_t* product = scratch_buffer(encoder, symbol_size);
+
+    for (uint64_t i = 0; i < encoder.m_accumulators; ++i)
+    {
+        uint16_t value = encoder.m_accumulator_coefficients[offset + i];
+        if (value == 0)
+            continue;
+
+        uint8_t coefficient[2] = {0, 0};
+        set_value(bits, coefficient, 0, value);
+        impl.write_symbol(product, coefficient);
+
+        uint8_t* accumulator =
+            encoder.m_accumulator_symbols.data() + i * symbol_size;
+        for (uint64_t j = 0; j < symbol_size; ++j)
+            accumulator[j] ^= product[j];
+    }
+
+    impl.set_window(window_lower_bound, window_symbols);
+}
+}
+
+void accumulate_push(kslide_encoder& encoder, uint64_t index)
+{
+    assert(encoder.m_accumulators > 0);
+
+    auto& coefficients = encoder.m_accumulator_coefficients;
+    for (uint64_t i = 0; i < encoder.m_accumulators; ++i)
+        coefficients.push_back(next_coefficient(encoder));
+
+    accumulate(encoder, index, coefficients.size() - encoder.m_accumulators);
+    encoder.m_work += encoder.m_accumulators;
+}
+
+void accumulate_pop(kslide_encoder& encoder)
+{
+    assert(encoder.m_accumulators > 0);
+
+    auto& coefficients = encoder.m_accumulator_coefficients;
+    assert(coefficients.size() >= encoder.m_accumulators);
+
+    accumulate(encoder, encoder.m_impl.stream_lower_bound(), 0);
+    encoder.m_work += encoder.m_accumulators;
+
+    coefficients.pop_front(encoder.m_accumulators);
+}
+
+void accumulate_reset(kslide_encoder& encoder)
+{
+    std::fill(encoder.m_accumulator_symbols.begin(),
+              encoder.m_accumulator_symbols.end(), 0);
+    encoder.m_accumulator_coefficients.clear();
+}
+}
+
+//------------------------------------------------------------------
+// ENCODER ACCUMULATOR API
+//------------------------------------------------------------------
+
+void kslide_encoder_set_accumulators(kslide_encoder_t* encoder,
+                                     uint64_t accumulators, uint64_t seed)
+{
+    assert(encoder != nullptr);
+
+    kodo_slide::encoder& impl = encoder->m_impl;
+
+    encoder->m_accumulators = accumulators;
+    encoder->m_accumulator_state = seed;
+    encoder->m_accumulator_symbols.assign(
+        accumulators * impl.symbol_size(), 0);
+    encoder->m_accumulator_coefficients.clear();
+
+    if (accumulators == 0)
+        return;
+
+    // Add the symbols already in the stream
+    for (uint64_t i = 0; i < impl.stream_symbols(); ++i)
+        kodo_slide_c::accumulate_push(*encoder, impl.stream_lower_bound() + i);
+}
+
+uint64_t kslide_encoder_accumulators(kslide_encoder_t* encoder)
+{
+    assert(encoder != nullptr);
+    return encoder->m_accumulators;
+}
+
+void kslide_encoder_write_accumulated_symbol(kslide_encoder_t* encoder,
+                                             uint64_t accumulator,
+                                             uint8_t* symbol,
+                                             uint8_t* coefficients)
+{
+    assert(encoder != nullptr);
+    assert(symbol != nullptr);
+    assert(coefficients != nullptr);
+    assert(accumulator < encoder->m_accumulators);
+
+    kodo_slide::encoder& impl = encoder->m_impl;
+    assert(impl.window_lower_bound() == impl.stream_lower_bound());
+    assert(impl.window_symbols() == impl.stream_symbols());
+
+    uint64_t symbol_size = impl.symbol_size();
+    memcpy(symbol,
+           encoder->m_accumulator_symbols.data() + accumulator * symbol_size,
+           symbol_size);
+
+    uint32_t bits = kodo_slide_c::field_bits(encoder->m_field);
+    memset(coefficients, 0, impl.coefficient_vector_size());
+
+    for (uint64_t i = 0; i < impl.stream_symbols(); ++i)
+    {
+        uint16_t value = encoder->m_accumulator_coefficients[
+            i * encoder->m_accumulators + accumulator];
+        kodo_slide_c::set_value(bits, coefficients, i, value);
+    }
+}
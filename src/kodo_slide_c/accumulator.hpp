@@ -0,0 +1,24 @@
+// Copyright Steinwurf ApS 2018.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include "wrappers.hpp"
+
+#include <cstdint>
+
+namespace kodo_slide_c
+{
+/// Adds the symbol just pushed to the front of the stream to the running
+/// repair symbols of the encoder
+void accumulate_push(kslide_encoder& encoder, uint64_t index);
+
+/// Removes the symbol at the back of the stream from the running repair
+/// symbols of the encoder. Must be called before the symbol is popped.
+void accumulate_pop(kslide_encoder& encoder);
+
+/// Clears the running repair symbols for an empty stream
+void accumulate_reset(kslide_encoder& encoder);
+}
@@ -0,0 +1,104 @@
+// Copyright Steinwurf ApS 2018.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include "allocator.hpp"
+#include "kodo_slide_c.h"
+
+#include <cassert>
+#include <cstdlib>
+
+#if defined(_WIN32)
+#include <malloc.h>
+#endif
+
+namespace
+{
+// The default allocator uses the aligned allocation functions of the
+// platform for all allocations, so a single free function can release both
+// kinds of allocations.
+void* default_malloc(void* context, uint64_t size)
+{
+    (void) context;
+#if defined(_WIN32)
+    return _aligned_malloc(size, alignof(std::max_align_t));
+#else
+    return malloc(size);
+#endif
+}
+
+void* default_aligned_alloc(void* context, uint64_t alignment, uint64_t size)
+{
+    (void) context;
+#if defined(_WIN32)
+    return _aligned_malloc(size, alignment);
+#else
+    if (alignment < sizeof(void*))
+        alignment = sizeof(void*);
+
+    void* ptr = nullptr;
+    if (posix_memalign(&ptr, alignment, size) != 0)
+        return nullptr;
+    return ptr;
+#endif
+}
+
+void default_free(void* context, void* ptr)
+{
+    (void) context;
+#if defined(_WIN32)
+    _aligned_free(ptr);
+#else
+    free(ptr);
+#endif
+}
+
+const kslide_allocator default_allocator =
+{
+    default_malloc, default_aligned_alloc, default_free, nullptr
+};
+
+kslide_allocator current_allocator = default_allocator;
+}
+
+namespace kodo_slide_c
+{
+void* allocate(uint64_t size)
+{
+    return current_allocator.m_malloc(current_allocator.m_context, size);
+}
+
+void* allocate_aligned(uint64_t alignment, uint64_t size)
+{
+    assert(alignment > 0 && (alignment & (alignment - 1)) == 0);
+    return current_allocator.m_aligned_alloc(
+        current_allocator.m_context, alignment, size);
+}
+
+void deallocate(void* ptr)
+{
+    if (ptr == nullptr)
+        return;
+
+    current_allocator.m_free(current_allocator.m_context, ptr);
+}
+}
+
+//------------------------------------------------------------------
+// ALLOCATOR API
+//------------------------------------------------------------------
+
+void kslide_set_allocator(const kslide_allocator* allocator)
+{
+    if (allocator == nullptr)
+    {
+        current_allocator = default_allocator;
+        return;
+    }
+
+    assert(allocator->m_malloc != nullptr);
+    assert(allocator->m_aligned_alloc != nullptr);
+    assert(allocator->m_free != nullptr);
+    current_allocator = *allocator;
+}
@@ -0,0 +1,88 @@
+// Copyright Steinwurf ApS 2018.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <new>
+#include <vector>
+
+namespace kodo_slide_c
+{
+/// Allocates memory with the allocator set by kslide_set_allocator(). The
+/// memory must be released with deallocate().
+void* allocate(uint64_t size);
+
+/// Allocates memory aligned to alignment, which must be a power of two.
+/// The memory must be released with deallocate().
+void* allocate_aligned(uint64_t alignment, uint64_t size);
+
+/// Releases memory from allocate() or allocate_aligned()
+void deallocate(void* ptr);
+
+/// Base class routing new and delete of the C API objects through the
+/// allocator
+struct allocated
+{
+    static void* operator new(std::size_t size)
+    {
+        void* ptr = allocate(size);
+        if (ptr == nullptr)
+            throw std::bad_alloc();
+        return ptr;
+    }
+
+    static void operator delete(void* ptr)
+    {
+        deallocate(ptr);
+    }
+};
+
+/// Standard library allocator using the allocator
+template<class T>
+struct allocator
+{
+    using value_type = T;
+
+    allocator() = default;
+
+    template<class U>
+    allocator(const allocator<U>&)
+    { }
+
+    T* allocate(std::size_t n)
+    {
+        void* ptr = kodo_slide_c::allocate(n * sizeof(T));
+        if (ptr == nullptr)
+            throw std::bad_alloc();
+        return static_cast<T*>(ptr);
+    }
+
+    void deallocate(T* ptr, std::size_t)
+    {
+        kodo_slide_c::deallocate(ptr);
+    }
+};
+
+template<class T, class U>
+bool operator==(const allocator<T>&, const allocator<U>&)
+{
+    return true;
+}
+
+template<class T, class U>
+bool operator!=(const allocator<T>&, const allocator<U>&)
+{
+    return false;
+}
+
+template<class T>
+using vector = std::vector<T, allocator<T>>;
+
+template<class T>
+using deque = std::deque<T, allocator<T>>;
+}
@@ -0,0 +1,106 @@
+// Copyright Steinwurf ApS 2018.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include "cauchy.hpp"
+#include "coefficient_codec.hpp"
+#include "kodo_slide_c.h"
+#include "wrappers.hpp"
+
+#include <cassert>
+#include <cstdint>
+
+//------------------------------------------------------------------
+// BLOCK API
+//------------------------------------------------------------------
+
+void kslide_encoder_set_block_symbols(kslide_encoder_t* encoder,
+                                      uint64_t block_symbols)
+{
+    assert(encoder != nullptr);
+    assert(block_symbols == 0 || !encoder->m_track_stream);
+    assert(block_symbols <= kslide_cauchy_max_symbols(encoder->m_field, 1));
+    encoder->m_block_symbols = block_symbols;
+
+    if (block_symbols > 0)
+        update_block_window(encoder->m_impl, block_symbols);
+}
+
+uint64_t kslide_encoder_block_symbols(kslide_encoder_t* encoder)
+{
+    assert(encoder != nullptr);
+    return encoder->m_block_symbols;
+}
+
+uint64_t kslide_encoder_block(kslide_encoder_t* encoder)
+{
+    assert(encoder != nullptr);
+    assert(encoder->m_block_symbols > 0);
+    return encoder->m_impl.window_lower_bound() / encoder->m_block_symbols;
+}
+
+void kslide_encoder_write_block_symbol(kslide_encoder_t* encoder,
+                                       uint8_t* symbol, uint8_t* coefficients,
+                                       uint64_t repair)
+{
+    assert(encoder != nullptr);
+    assert(encoder->m_block_symbols > 0);
+    assert(encoder->m_impl.window_symbols() > 0);
+
+    // The columns of the Cauchy matrix are the offsets in the block, so the
+    // repair symbols of a block are rows of the same matrix even when part
+    // of the block has been popped in between
+    uint64_t first =
+        encoder->m_impl.window_lower_bound() % encoder->m_block_symbols;
+    uint64_t symbols = encoder->m_impl.window_symbols();
+    assert(first + symbols <=
+           kslide_cauchy_max_symbols(encoder->m_field, repair + 1));
+
+    kodo_slide_c::generate_cauchy(
+        kodo_slide_c::field_bits(encoder->m_field), first, symbols, repair,
+        coefficients);
+    kslide_encoder_write_symbol(encoder, symbol, coefficients);
+}
+
+void kslide_decoder_set_block_symbols(kslide_decoder_t* decoder,
+                                      uint64_t block_symbols)
+{
+    assert(decoder != nullptr);
+    assert(block_symbols == 0 || !decoder->m_track_stream);
+    assert(block_symbols <= kslide_cauchy_max_symbols(decoder->m_field, 1));
+    decoder->m_block_symbols = block_symbols;
+}
+
+uint64_t kslide_decoder_block_symbols(kslide_decoder_t* decoder)
+{
+    assert(decoder != nullptr);
+    return decoder->m_block_symbols;
+}
+
+void kslide_decoder_read_block_symbol(kslide_decoder_t* decoder,
+                                      uint8_t* symbol, uint8_t* coefficients,
+                                      uint64_t lower_bound, uint64_t symbols,
+                                      uint64_t repair)
+{
+    assert(decoder != nullptr);
+    assert(decoder->m_block_symbols > 0);
+    assert(symbols > 0 && symbols <= decoder->m_block_symbols);
+
+    // The window of the encoder covers the symbols of a block which are
+    // still in its stream, so it may start after the block does
+    assert(lower_bound / decoder->m_block_symbols ==
+           (lower_bound + symbols - 1) / decoder->m_block_symbols);
+    assert(lower_bound >= decoder->m_impl.stream_lower_bound());
+    assert(lower_bound + symbols <= decoder->m_impl.stream_upper_bound());
+
+    uint64_t first = lower_bound % decoder->m_block_symbols;
+    assert(first + symbols <=
+           kslide_cauchy_max_symbols(decoder->m_field, repair + 1));
+
+    kslide_decoder_set_window(decoder, lower_bound, symbols);
+    kodo_slide_c::generate_cauchy(
+        kodo_slide_c::field_bits(decoder->m_field), first, symbols, repair,
+        coefficients);
+    kslide_decoder_read_symbol(decoder, symbol, coefficients);
+}
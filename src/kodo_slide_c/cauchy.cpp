@@ -0,0 +1,125 @@
+// Copyright Steinwurf ApS 2018.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include "cauchy.hpp"
+#include "coefficient_codec.hpp"
+#include "kodo_slide_c.h"
+#include "wrappers.hpp"
+
+#include <cassert>
+#include <cstring>
+#include <vector>
+
+namespace kodo_slide_c
+{
+namespace
+{
+/// The multiplicative inverses of the elements of a field. The tables live
+/// for the lifetime of the process, so they use the default heap rather
+/// than the allocator set by kslide_set_allocator().
+struct inverse_table
+{
+    inverse_table(uint32_t bits, uint32_t polynomial) :
+        m_inverse(field_order(bits), 0)
+    {
+        uint32_t order = field_order(bits);
+
+        // Walk the powers of the generator x
+        std::vector<uint16_t> power(order - 1);
+        uint32_t value = 1;
+        for (uint32_t i = 0; i < order - 1; ++i)
+        {
+            power[i] = static_cast<uint16_t>(value);
+            value <<= 1;
+            if (value & order)
+                value ^= polynomial;
+        }
+
+        for (uint32_t i = 0; i < order - 1; ++i)
+            m_inverse[power[i]] = power[(order - 1 - i) % (order - 1)];
+    }
+
+    std::vector<uint16_t> m_inverse;
+};
+
+const inverse_table& inverse(uint32_t bits)
+{
+    switch (bits)
+    {
+    case 4:
+    {
+        static const inverse_table table(4, 0x13);
+        return table;
+    }
+    case 8:
+    {
+        static const inverse_table table(8, 0x11D);
+        return table;
+    }
+    default:
+    {
+        assert(bits == 16);
+        static const inverse_table table(16, 0x1100B);
+        return table;
+    }
+    }
+}
+}
+
+uint32_t field_order(uint32_t bits)
+{
+    return 1U << bits;
+}
+
+void generate_cauchy(uint32_t bits, uint64_t first, uint64_t symbols,
+                     uint64_t repair, uint8_t* coefficients)
+{
+    assert(bits >= 4);
+    assert(repair + first + symbols < field_order(bits));
+
+    const std::vector<uint16_t>& inverse_of = inverse(bits).m_inverse;
+    uint32_t x = field_order(bits) - 1 - static_cast<uint32_t>(repair);
+
+    memset(coefficients, 0, coefficient_vector_size(bits, symbols));
+    for (uint64_t j = 0; j < symbols; ++j)
+    {
+        uint32_t y = static_cast<uint32_t>(first + j);
+        set_value(bits, coefficients, j, inverse_of[x ^ y]);
+    }
+}
+}
+
+//------------------------------------------------------------------
+// CAUCHY COEFFICIENT API
+//------------------------------------------------------------------
+
+uint64_t kslide_cauchy_max_symbols(int32_t c_field, uint64_t repairs)
+{
+    uint32_t bits = kodo_slide_c::field_bits(c_field);
+    if (bits == 1 || repairs >= kodo_slide_c::field_order(bits))
+        return 0;
+
+    return kodo_slide_c::field_order(bits) - repairs;
+}
+
+void kslide_encoder_generate_cauchy(kslide_encoder_t* encoder,
+                                    uint64_t repair, uint8_t* coefficients)
+{
+    assert(encoder != nullptr);
+    assert(coefficients != nullptr);
+    kodo_slide_c::generate_cauchy(
+        kodo_slide_c::field_bits(encoder->m_field), 0,
+        encoder->m_impl.window_symbols(), repair, coefficients);
+}
+
+void kslide_decoder_generate_cauchy(kslide_decoder_t* decoder,
+                                    uint64_t repair, uint8_t* coefficients)
+{
+    assert(decoder != nullptr);
+    assert(coefficients != nullptr);
+    kodo_slide_c::generate_cauchy(
+        kodo_slide_c::field_bits(decoder->m_field), 0,
+        decoder->m_impl.window_symbols(), repair, coefficients);
+}
@@ -0,0 +1,41 @@
+// Copyright Steinwurf ApS 2018.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cstdint>
+
+namespace kodo_slide_c
+{
+/// Structured coefficients from a Cauchy matrix. The coefficient of window
+/// position j in repair symbol r is
+///
+///     1 / (x_r + y_j), with x_r = order - 1 - r and y_j = first + j
+///
+/// where order is the number of field elements and first is the column of
+/// the first window symbol. The x and y values are distinct as long as the
+/// repair index r satisfies r + first + window symbols < order, and then
+/// every square submatrix is invertible: any k repair symbols can replace
+/// any k lost symbols of the columns.
+///
+/// Repair symbols of windows with different first columns are rows of the
+/// same matrix, e.g. the windows of a block before and after some of its
+/// symbols are popped, when the column of a symbol is its offset in the
+/// block.
+///
+/// The arithmetic uses the same prime polynomials as the kodo-slide fields.
+
+/// @return The number of elements of a field with the given bits
+uint32_t field_order(uint32_t bits);
+
+/// Writes the Cauchy coefficients of a repair symbol.
+/// @param bits The number of bits per coefficient, at least 4
+/// @param first The column of the first symbol of the window
+/// @param symbols The number of symbols in the window
+/// @param repair The index of the repair symbol
+/// @param coefficients The coefficient vector to write
+void generate_cauchy(uint32_t bits, uint64_t first, uint64_t symbols,
+                     uint64_t repair, uint8_t* coefficients);
+}
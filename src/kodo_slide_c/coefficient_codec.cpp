@@ -0,0 +1,449 @@
+// Copyright Steinwurf ApS 2018.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include "coefficient_codec.hpp"
+#include "kodo_slide_c.h"
+#include "wrappers.hpp"
+
+#include <cassert>
+#include <cstring>
+
+namespace kodo_slide_c
+{
+uint32_t get_value(uint32_t bits, const uint8_t* data, uint64_t index)
+{
+    switch (bits)
+    {
+    case 1:
+        return (data[index / 8] >> (index % 8)) & 0x1;
+    case 4:
+        return (data[index / 2] >> (4 * (index % 2))) & 0xF;
+    case 8:
+        return data[index];
+    default:
+        return data[2 * index] | (data[2 * index + 1] << 8);
+    }
+}
+
+void set_value(uint32_t bits, uint8_t* data, uint64_t index, uint32_t value)
+{
+    switch (bits)
+    {
+    case 1:
+        data[index / 8] |= value << (index % 8);
+        break;
+    case 4:
+        data[index / 2] |= value << (4 * (index % 2));
+        break;
+    case 8:
+        data[index] = static_cast<uint8_t>(value);
+        break;
+    default:
+        data[2 * index] = static_cast<uint8_t>(value);
+        data[2 * index + 1] = static_cast<uint8_t>(value >> 8);
+        break;
+    }
+}
+
+uint64_t varint_size(uint64_t value)
+{
+    uint64_t size = 1;
+    while (value >= 0x80)
+    {
+        value >>= 7;
+        ++size;
+    }
+    return size;
+}
+
+uint8_t* write_varint(uint8_t* data, uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        *data++ = static_cast<uint8_t>(value | 0x80);
+        value >>= 7;
+    }
+    *data++ = static_cast<uint8_t>(value);
+    return data;
+}
+
+const uint8_t* read_varint(const uint8_t* data, const uint8_t* end,
+                           uint64_t& value)
+{
+    value = 0;
+    for (uint32_t shift = 0; data < end && shift < 64; shift += 7)
+    {
+        uint8_t byte = *data++;
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80))
+            return data;
+    }
+    return nullptr;
+}
+
+namespace
+{
+enum representation : uint8_t
+{
+    representation_raw = 0,
+    representation_sparse = 1,
+    representation_runs = 2
+};
+
+/// Zero the unused bits of the last byte of a coefficient vector
+void clear_padding(uint32_t bits, uint64_t symbols, uint8_t* data)
+{
+    uint64_t used_bits = symbols * bits;
+    if (used_bits % 8 != 0)
+    {
+        data[used_bits / 8] &= static_cast<uint8_t>((1U << (used_bits % 8)) - 1);
+    }
+}
+
+/// The size of the packed values of the non-zero coefficients
+uint64_t values_size(uint32_t bits, uint64_t non_zero)
+{
+    return bits == 1 ? 0 : coefficient_vector_size(bits, non_zero);
+}
+
+/// Write the values of the non-zero coefficients bit packed
+uint8_t* write_values(uint32_t bits, uint64_t symbols,
+                      const uint8_t* coefficients, uint64_t non_zero,
+                      uint8_t* data)
+{
+    if (bits == 1)
+        return data;
+
+    uint64_t size = values_size(bits, non_zero);
+    memset(data, 0, size);
+
+    uint64_t position = 0;
+    for (uint64_t i = 0; i < symbols; ++i)
+    {
+        uint32_t value = get_value(bits, coefficients, i);
+        if (value != 0)
+            set_value(bits, data, position++, value);
+    }
+    return data + size;
+}
+
+/// Finds the (zeros, literals) run starting at index
+/// @return The index after the run
+uint64_t next_run(uint32_t bits, uint64_t symbols, const uint8_t* coefficients,
+                  uint64_t index, uint64_t& zeros, uint64_t& literals)
+{
+    zeros = 0;
+    while (index < symbols && get_value(bits, coefficients, index) == 0)
+    {
+        ++zeros;
+        ++index;
+    }
+
+    literals = 0;
+    while (index < symbols && get_value(bits, coefficients, index) != 0)
+    {
+        ++literals;
+        ++index;
+    }
+    return index;
+}
+
+/// Sets the coefficient at position to the next of the packed values
+/// @return false if the value is zero
+bool set_next_value(uint32_t bits, const uint8_t* values, uint64_t& value_index,
+                    uint64_t position, uint8_t* coefficients)
+{
+    uint32_t value = bits == 1 ? 1 : get_value(bits, values, value_index);
+    ++value_index;
+    if (value == 0)
+        return false;
+
+    set_value(bits, coefficients, position, value);
+    return true;
+}
+}
+
+uint32_t field_bits(int32_t c_field)
+{
+    switch (c_field)
+    {
+    case kslide_binary:
+        return 1;
+    case kslide_binary4:
+        return 4;
+    case kslide_binary8:
+        return 8;
+    case kslide_binary16:
+        return 16;
+    default:
+        assert(false && "Unknown field");
+        return 8;
+    }
+}
+
+uint64_t coefficient_vector_size(uint32_t bits, uint64_t symbols)
+{
+    return (symbols * bits + 7) / 8;
+}
+
+uint64_t max_compressed_size(uint32_t bits, uint64_t symbols)
+{
+    // The raw representation is always a candidate
+    return 1 + coefficient_vector_size(bits, symbols);
+}
+
+uint64_t compress_coefficients(uint32_t bits, uint64_t symbols,
+                               const uint8_t* coefficients, uint8_t* data)
+{
+    assert(coefficients != nullptr);
+    assert(data != nullptr);
+
+    uint64_t non_zero = 0;
+    for (uint64_t i = 0; i < symbols; ++i)
+    {
+        non_zero += get_value(bits, coefficients, i) != 0;
+    }
+
+    uint64_t raw_size = 1 + coefficient_vector_size(bits, symbols);
+    uint64_t sparse_size = 1 + coefficient_vector_size(1, symbols) +
+                           values_size(bits, non_zero);
+
+    // The runs are counted here and found again when written, so no
+    // memory is needed for them
+    uint64_t runs = 0;
+    uint64_t runs_size = 1 + values_size(bits, non_zero);
+    for (uint64_t i = 0; i < symbols; ++runs)
+    {
+        uint64_t zeros;
+        uint64_t literals;
+        i = next_run(bits, symbols, coefficients, i, zeros, literals);
+        runs_size += varint_size(zeros) + varint_size(literals);
+    }
+    runs_size += varint_size(runs);
+
+    if (raw_size <= sparse_size && raw_size <= runs_size)
+    {
+        data[0] = representation_raw;
+        memcpy(data + 1, coefficients, raw_size - 1);
+        clear_padding(bits, symbols, data + 1);
+        return raw_size;
+    }
+
+    uint8_t* output = data;
+    if (sparse_size <= runs_size)
+    {
+        *output++ = representation_sparse;
+        uint64_t bitmap_size = coefficient_vector_size(1, symbols);
+        memset(output, 0, bitmap_size);
+        for (uint64_t i = 0; i < symbols; ++i)
+        {
+            if (get_value(bits, coefficients, i) != 0)
+                set_value(1, output, i, 1);
+        }
+        output += bitmap_size;
+    }
+    else
+    {
+        *output++ = representation_runs;
+        output = write_varint(output, runs);
+        for (uint64_t i = 0; i < symbols;)
+        {
+            uint64_t zeros;
+            uint64_t literals;
+            i = next_run(bits, symbols, coefficients, i, zeros, literals);
+            output = write_varint(output, zeros);
+            output = write_varint(output, literals);
+        }
+    }
+
+    output = write_values(bits, symbols, coefficients, non_zero, output);
+    return output - data;
+}
+
+uint64_t decompress_coefficients(uint32_t bits, uint64_t symbols,
+                                 const uint8_t* data, uint64_t size,
+                                 uint8_t* coefficients)
+{
+    assert(data != nullptr);
+    assert(coefficients != nullptr);
+
+    if (size == 0)
+        return 0;
+
+    const uint8_t* input = data + 1;
+    const uint8_t* end = data + size;
+    uint64_t vector_size = coefficient_vector_size(bits, symbols);
+    memset(coefficients, 0, vector_size);
+
+    // The representations storing the values separately are parsed twice,
+    // first to validate them and count the values and then to place the
+    // values. This way no memory is needed for the positions.
+    const uint8_t* positions = input;
+    uint64_t count = 0;
+    uint64_t non_zero = 0;
+
+    switch (data[0])
+    {
+    case representation_raw:
+        if (static_cast<uint64_t>(end - input) < vector_size)
+            return 0;
+
+        memcpy(coefficients, input, vector_size);
+        clear_padding(bits, symbols, coefficients);
+        return 1 + vector_size;
+
+    case representation_sparse:
+    {
+        uint64_t bitmap_size = coefficient_vector_size(1, symbols);
+        if (static_cast<uint64_t>(end - input) < bitmap_size)
+            return 0;
+
+        for (uint64_t i = 0; i < symbols; ++i)
+        {
+            non_zero += get_value(1, input, i);
+        }
+        input += bitmap_size;
+        break;
+    }
+
+    case representation_runs:
+    {
+        input = read_varint(input, end, count);
+        if (input == nullptr || count > symbols)
+            return 0;
+
+        positions = input;
+        uint64_t position = 0;
+        for (uint64_t i = 0; i < count; ++i)
+        {
+            uint64_t zeros;
+            uint64_t literals;
+            input = read_varint(input, end, zeros);
+            if (input == nullptr)
+                return 0;
+            input = read_varint(input, end, literals);
+            if (input == nullptr)
+                return 0;
+            if (zeros > symbols - position ||
+                literals > symbols - position - zeros)
+            {
+                return 0;
+            }
+
+            position += zeros + literals;
+            non_zero += literals;
+        }
+        break;
+    }
+
+    default:
+        return 0;
+    }
+
+    if (static_cast<uint64_t>(end - input) < values_size(bits, non_zero))
+        return 0;
+
+    uint64_t value_index = 0;
+    if (data[0] == representation_sparse)
+    {
+        for (uint64_t i = 0; i < symbols; ++i)
+        {
+            if (get_value(1, positions, i) &&
+                !set_next_value(bits, input, value_index, i, coefficients))
+            {
+                return 0;
+            }
+        }
+    }
+    else
+    {
+        uint64_t position = 0;
+        for (uint64_t i = 0; i < count; ++i)
+        {
+            uint64_t zeros;
+            uint64_t literals;
+            positions = read_varint(positions, end, zeros);
+            positions = read_varint(positions, end, literals);
+
+            position += zeros;
+            for (uint64_t j = 0; j < literals; ++j)
+            {
+                if (!set_next_value(bits, input, value_index, position++,
+                                    coefficients))
+                {
+                    return 0;
+                }
+            }
+        }
+    }
+
+    input += values_size(bits, non_zero);
+    return input - data;
+}
+}
+
+//------------------------------------------------------------------
+// COEFFICIENT COMPRESSION API
+//------------------------------------------------------------------
+
+uint64_t kslide_coefficients_max_compressed_size(int32_t c_field,
+                                                 uint64_t symbols)
+{
+    return kodo_slide_c::max_compressed_size(
+        kodo_slide_c::field_bits(c_field), symbols);
+}
+
+uint64_t kslide_compress_coefficients(int32_t c_field, uint64_t symbols,
+                                      const uint8_t* coefficients,
+                                      uint8_t* data)
+{
+    assert(coefficients != nullptr);
+    assert(data != nullptr);
+    return kodo_slide_c::compress_coefficients(
+        kodo_slide_c::field_bits(c_field), symbols, coefficients, data);
+}
+
+uint64_t kslide_decompress_coefficients(int32_t c_field, uint64_t symbols,
+                                        const uint8_t* data, uint64_t size,
+                                        uint8_t* coefficients)
+{
+    assert(data != nullptr);
+    assert(coefficients != nullptr);
+    return kodo_slide_c::decompress_coefficients(
+        kodo_slide_c::field_bits(c_field), symbols, data, size, coefficients);
+}
+
+uint64_t kslide_encoder_compress_coefficients(kslide_encoder_t* encoder,
+                                              const uint8_t* coefficients,
+                                              uint8_t* data)
+{
+    assert(encoder != nullptr);
+    return kslide_compress_coefficients(
+        encoder->m_field, encoder->m_impl.window_symbols(), coefficients,
+        data);
+}
+
+uint64_t kslide_decoder_read_compressed_symbol(kslide_decoder_t* decoder,
+                                               uint8_t* symbol,
+                                               const uint8_t* data,
+                                               uint64_t size)
+{
+    assert(decoder != nullptr);
+    assert(symbol != nullptr);
+    assert(data != nullptr);
+
+    uint8_t* coefficients = scratch_buffer(
+        *decoder, decoder->m_impl.coefficient_vector_size());
+
+    uint64_t read = kslide_decompress_coefficients(
+        decoder->m_field, decoder->m_impl.window_symbols(), data, size,
+        coefficients);
+
+    if (read == 0)
+        return 0;
+
+    kslide_decoder_read_symbol(decoder, symbol, coefficients);
+    return read;
+}
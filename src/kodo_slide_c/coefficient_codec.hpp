@@ -0,0 +1,65 @@
+// Copyright Steinwurf ApS 2018.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cstdint>
+
+namespace kodo_slide_c
+{
+/// Compact wire format for coefficient vectors. The encoder picks the
+/// smallest of three representations:
+///
+///   raw:    the coefficient vector as is
+///   sparse: a bitmap of the non-zero coefficients followed by their values
+///   runs:   (zeros, literals) run lengths followed by the literal values
+///
+/// The first byte identifies the representation. Run lengths are stored as
+/// LEB128 varints and values are bit packed with the width of the field.
+/// For the binary field the values of non-zero coefficients are implied.
+///
+/// The coefficients are addressed element by element and the padding bits
+/// of the last byte of the vector are always written as zero.
+
+/// @return The number of bits per coefficient of a kslide_finite_field
+uint32_t field_bits(int32_t c_field);
+
+/// @return The coefficient at index of a coefficient vector
+uint32_t get_value(uint32_t bits, const uint8_t* data, uint64_t index);
+
+/// Sets the coefficient at index of a coefficient vector. The coefficient
+/// must be zero before it is set.
+void set_value(uint32_t bits, uint8_t* data, uint64_t index, uint32_t value);
+
+/// @return The size of a LEB128 varint in bytes
+uint64_t varint_size(uint64_t value);
+
+/// Writes a LEB128 varint
+/// @return The position after the varint
+uint8_t* write_varint(uint8_t* data, uint64_t value);
+
+/// Reads a LEB128 varint
+/// @return The position after the varint, or nullptr if data ends first
+const uint8_t* read_varint(const uint8_t* data, const uint8_t* end,
+                           uint64_t& value);
+
+/// @return The size in bytes of a vector of the given number of
+///         coefficients
+uint64_t coefficient_vector_size(uint32_t bits, uint64_t symbols);
+
+/// @return The largest possible compressed size in bytes
+uint64_t max_compressed_size(uint32_t bits, uint64_t symbols);
+
+/// Compress a coefficient vector
+/// @return The number of bytes written to data
+uint64_t compress_coefficients(uint32_t bits, uint64_t symbols,
+                               const uint8_t* coefficients, uint8_t* data);
+
+/// Decompress a coefficient vector
+/// @return The number of bytes read from data, or 0 if data is invalid
+uint64_t decompress_coefficients(uint32_t bits, uint64_t symbols,
+                                 const uint8_t* data, uint64_t size,
+                                 uint8_t* coefficients);
+}
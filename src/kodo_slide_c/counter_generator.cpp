@@ -0,0 +1,162 @@
+// Copyright Steinwurf ApS 2018.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include "coefficient_codec.hpp"
+#include "counter_generator.hpp"
+#include "kodo_slide_c.h"
+#include "wrappers.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+namespace kodo_slide_c
+{
+namespace
+{
+const uint32_t philox_m0 = 0xD2511F53;
+const uint32_t philox_m1 = 0xCD9E8D57;
+const uint32_t philox_w0 = 0x9E3779B9;
+const uint32_t philox_w1 = 0xBB67AE85;
+const uint32_t philox_rounds = 10;
+
+void store(uint8_t* data, uint32_t value)
+{
+    data[0] = static_cast<uint8_t>(value);
+    data[1] = static_cast<uint8_t>(value >> 8);
+    data[2] = static_cast<uint8_t>(value >> 16);
+    data[3] = static_cast<uint8_t>(value >> 24);
+}
+}
+
+void philox(uint64_t key, uint64_t counter, uint8_t* block)
+{
+    uint32_t k0 = static_cast<uint32_t>(key);
+    uint32_t k1 = static_cast<uint32_t>(key >> 32);
+    uint32_t c0 = static_cast<uint32_t>(counter);
+    uint32_t c1 = static_cast<uint32_t>(counter >> 32);
+    uint32_t c2 = 0;
+    uint32_t c3 = 0;
+
+    for (uint32_t round = 0; round < philox_rounds; ++round)
+    {
+        uint64_t p0 = static_cast<uint64_t>(philox_m0) * c0;
+        uint64_t p1 = static_cast<uint64_t>(philox_m1) * c2;
+
+        uint32_t hi0 = static_cast<uint32_t>(p0 >> 32);
+        uint32_t lo0 = static_cast<uint32_t>(p0);
+        uint32_t hi1 = static_cast<uint32_t>(p1 >> 32);
+        uint32_t lo1 = static_cast<uint32_t>(p1);
+
+        c0 = hi1 ^ c1 ^ k0;
+        c1 = lo1;
+        c2 = hi0 ^ c3 ^ k1;
+        c3 = lo0;
+
+        k0 += philox_w0;
+        k1 += philox_w1;
+    }
+
+    store(block, c0);
+    store(block + 4, c1);
+    store(block + 8, c2);
+    store(block + 12, c3);
+}
+
+void generate_counter(uint32_t bits, uint64_t seed, uint64_t lower_bound,
+                      uint64_t symbols, uint8_t* coefficients)
+{
+    assert(coefficients != nullptr);
+    memset(coefficients, 0, coefficient_vector_size(bits, symbols));
+
+    if (symbols == 0)
+        return;
+
+    const uint64_t per_block = 128 / bits;
+    uint64_t upper_bound = lower_bound + symbols;
+    uint8_t block[16];
+
+    for (uint64_t b = lower_bound / per_block;
+         b <= (upper_bound - 1) / per_block; ++b)
+    {
+        philox(seed, b, block);
+
+        uint64_t first = std::max(lower_bound, b * per_block);
+        uint64_t last = std::min(upper_bound, (b + 1) * per_block);
+
+        // Whole bytes are copied as they are
+        if (bits >= 8)
+        {
+            uint64_t bytes = bits / 8;
+            memcpy(coefficients + (first - lower_bound) * bytes,
+                   block + (first - b * per_block) * bytes,
+                   (last - first) * bytes);
+            continue;
+        }
+
+        for (uint64_t i = first; i < last; ++i)
+        {
+            set_value(bits, coefficients, i - lower_bound,
+                      get_value(bits, block, i - b * per_block));
+        }
+    }
+}
+}
+
+//------------------------------------------------------------------
+// COEFFICIENT GENERATOR API
+//------------------------------------------------------------------
+
+void kslide_encoder_factory_set_generator(kslide_encoder_factory_t* factory,
+                                          int32_t generator)
+{
+    assert(factory != nullptr);
+    assert(generator == kslide_generator_default ||
+           generator == kslide_generator_counter);
+    factory->m_generator = generator;
+}
+
+int32_t kslide_encoder_factory_generator(kslide_encoder_factory_t* factory)
+{
+    assert(factory != nullptr);
+    return factory->m_generator;
+}
+
+void kslide_decoder_factory_set_generator(kslide_decoder_factory_t* factory,
+                                          int32_t generator)
+{
+    assert(factory != nullptr);
+    assert(generator == kslide_generator_default ||
+           generator == kslide_generator_counter);
+    factory->m_generator = generator;
+}
+
+int32_t kslide_decoder_factory_generator(kslide_decoder_factory_t* factory)
+{
+    assert(factory != nullptr);
+    return factory->m_generator;
+}
+
+int32_t kslide_encoder_generator(kslide_encoder_t* encoder)
+{
+    assert(encoder != nullptr);
+    return encoder->m_generator;
+}
+
+int32_t kslide_decoder_generator(kslide_decoder_t* decoder)
+{
+    assert(decoder != nullptr);
+    return decoder->m_generator;
+}
+
+void kslide_generate_counter_coefficients(int32_t c_field, uint64_t seed,
+                                          uint64_t lower_bound,
+                                          uint64_t symbols,
+                                          uint8_t* coefficients)
+{
+    assert(coefficients != nullptr);
+    kodo_slide_c::generate_counter(kodo_slide_c::field_bits(c_field), seed,
+                                   lower_bound, symbols, coefficients);
+}
@@ -0,0 +1,34 @@
+// Copyright Steinwurf ApS 2018.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cstdint>
+
+namespace kodo_slide_c
+{
+/// Counter based coefficient generator. The coefficients are the output of
+/// the Philox4x32-10 block function keyed by the seed, where block b holds
+/// the 128 / bits coefficients of the stream indices
+/// [b * 128 / bits, (b + 1) * 128 / bits). A coefficient only depends on
+/// the seed and its stream index, so any slice of a window can be generated
+/// on its own, and the blocks are independent of each other.
+
+/// Computes a Philox4x32-10 block
+/// @param key The key, i.e. the seed
+/// @param counter The counter, i.e. the block index
+/// @param block The 16 bytes of output, as little endian 32 bit words
+void philox(uint64_t key, uint64_t counter, uint8_t* block);
+
+/// Writes the counter based coefficients of the stream indices
+/// [lower_bound, lower_bound + symbols)
+/// @param bits The number of bits per coefficient
+/// @param seed The seed of the coefficients
+/// @param lower_bound The stream index of the first coefficient
+/// @param symbols The number of coefficients
+/// @param coefficients The coefficient vector to write
+void generate_counter(uint32_t bits, uint64_t seed, uint64_t lower_bound,
+                      uint64_t symbols, uint8_t* coefficients);
+}
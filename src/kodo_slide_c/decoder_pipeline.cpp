@@ -0,0 +1,342 @@
+// Copyright Steinwurf ApS 2018.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include "allocator.hpp"
+#include "kodo_slide_c.h"
+#include "spsc_queue.hpp"
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+
+namespace
+{
+enum class command
+{
+    push_front_symbol,
+    pop_back_symbol,
+    read_symbol,
+    read_seeded_symbol,
+    read_source_symbol
+};
+
+struct packet
+{
+    command m_command;
+    uint64_t m_index;
+    uint64_t m_window_lower_bound;
+    uint64_t m_window_symbols;
+    uint64_t m_seed;
+    uint8_t* m_storage;
+    kodo_slide_c::vector<uint8_t> m_symbol;
+    kodo_slide_c::vector<uint8_t> m_coefficients;
+};
+
+/// Wait strategy used when a queue is empty or full. Spin briefly to keep
+/// the latency low and then back off to avoid burning a core.
+class backoff
+{
+public:
+    void reset()
+    {
+        m_spins = 0;
+    }
+
+    void wait()
+    {
+        if (m_spins < 64)
+        {
+            ++m_spins;
+            std::this_thread::yield();
+        }
+        else
+        {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+    }
+
+private:
+    uint32_t m_spins = 0;
+};
+}
+
+struct kslide_decoder_pipeline : kodo_slide_c::allocated
+{
+    kslide_decoder_pipeline(kslide_decoder_t* decoder, uint64_t queue_size,
+                            uint64_t max_coefficient_vector_size) :
+        m_decoder(decoder),
+        m_packets(queue_size),
+        m_events(queue_size)
+    {
+        uint64_t symbol_size = kslide_decoder_symbol_size(decoder);
+        for (uint64_t i = 0; i < m_packets.slots(); ++i)
+        {
+            m_packets.slot(i).m_symbol.resize(symbol_size);
+            m_packets.slot(i).m_coefficients.resize(
+                max_coefficient_vector_size);
+        }
+
+        // Symbols decoded before the pipeline was started are not reported
+        uint64_t lower_bound = kslide_decoder_stream_lower_bound(decoder);
+        for (uint64_t i = 0; i < kslide_decoder_stream_symbols(decoder); ++i)
+        {
+            uint8_t decoded =
+                kslide_decoder_is_symbol_decoded(decoder, lower_bound + i);
+            m_reported.push_back(decoded);
+            m_reported_symbols += decoded;
+        }
+
+        m_worker = std::thread(&kslide_decoder_pipeline::run, this);
+    }
+
+    ~kslide_decoder_pipeline()
+    {
+        m_stop.store(true, std::memory_order_release);
+        m_worker.join();
+    }
+
+    void run()
+    {
+        backoff wait;
+        while (true)
+        {
+            packet* p = m_packets.read_slot();
+            if (p == nullptr)
+            {
+                if (m_stop.load(std::memory_order_acquire) && m_packets.empty())
+                    return;
+
+                wait.wait();
+                continue;
+            }
+
+            wait.reset();
+            process(*p);
+            m_packets.commit_read();
+        }
+    }
+
+    void process(packet& p)
+    {
+        switch (p.m_command)
+        {
+        case command::push_front_symbol:
+            kslide_decoder_push_front_symbol(m_decoder, p.m_storage);
+            m_reported.push_back(0);
+            return;
+        case command::pop_back_symbol:
+        {
+            assert(!m_reported.empty());
+            m_reported_symbols -= m_reported.front();
+            m_reported.pop_front();
+            uint64_t index = kslide_decoder_pop_back_symbol(m_decoder);
+            emit(kslide_pipeline_symbol_popped, index);
+            return;
+        }
+        case command::read_symbol:
+            kslide_decoder_set_window(
+                m_decoder, p.m_window_lower_bound, p.m_window_symbols);
+            assert(kslide_decoder_coefficient_vector_size(m_decoder) <=
+                   p.m_coefficients.size());
+            kslide_decoder_read_symbol(
+                m_decoder, p.m_symbol.data(), p.m_coefficients.data());
+            break;
+        case command::read_seeded_symbol:
+            kslide_decoder_set_window(
+                m_decoder, p.m_window_lower_bound, p.m_window_symbols);
+            p.m_coefficients.resize(
+                kslide_decoder_coefficient_vector_size(m_decoder));
+            kslide_decoder_set_seed(m_decoder, p.m_seed);
+            kslide_decoder_generate(m_decoder, p.m_coefficients.data());
+            kslide_decoder_read_symbol(
+                m_decoder, p.m_symbol.data(), p.m_coefficients.data());
+            break;
+        case command::read_source_symbol:
+            kslide_decoder_read_source_symbol(
+                m_decoder, p.m_symbol.data(), p.m_index);
+            break;
+        }
+
+        report_decoded();
+    }
+
+    /// Emit an event for every symbol decoded since the last report. The
+    /// stream is only scanned if the number of decoded symbols has changed.
+    void report_decoded()
+    {
+        if (kslide_decoder_symbols_decoded(m_decoder) == m_reported_symbols)
+            return;
+
+        uint64_t lower_bound = kslide_decoder_stream_lower_bound(m_decoder);
+        for (uint64_t i = 0; i < m_reported.size(); ++i)
+        {
+            if (m_reported[i] ||
+                !kslide_decoder_is_symbol_decoded(m_decoder, lower_bound + i))
+            {
+                continue;
+            }
+
+            m_reported[i] = 1;
+            ++m_reported_symbols;
+            emit(kslide_pipeline_symbol_decoded, lower_bound + i);
+        }
+    }
+
+    void emit(int32_t type, uint64_t index)
+    {
+        backoff wait;
+        kslide_pipeline_event* event;
+        while ((event = m_events.write_slot()) == nullptr)
+        {
+            // Drop the events if nobody will read them anymore
+            if (m_stop.load(std::memory_order_acquire))
+                return;
+
+            wait.wait();
+        }
+
+        event->m_type = type;
+        event->m_index = index;
+        m_events.commit_write();
+    }
+
+    kslide_decoder_t* m_decoder;
+    kodo_slide_c::spsc_queue<packet> m_packets;
+    kodo_slide_c::spsc_queue<kslide_pipeline_event> m_events;
+
+    // Only accessed by the worker: one flag per stream symbol indicating
+    // whether its decoded event has been emitted
+    kodo_slide_c::deque<uint8_t> m_reported;
+    uint64_t m_reported_symbols = 0;
+
+    std::atomic<bool> m_stop{false};
+    std::thread m_worker;
+};
+
+kslide_decoder_pipeline_t* kslide_new_decoder_pipeline(
+    kslide_decoder_t* decoder, uint64_t queue_size,
+    uint64_t max_coefficient_vector_size)
+{
+    assert(decoder != nullptr);
+    assert(queue_size > 0);
+    return new kslide_decoder_pipeline(
+        decoder, queue_size, max_coefficient_vector_size);
+}
+
+void kslide_delete_decoder_pipeline(kslide_decoder_pipeline_t* pipeline)
+{
+    assert(pipeline != nullptr);
+    delete pipeline;
+}
+
+uint8_t kslide_decoder_pipeline_push_front_symbol(
+    kslide_decoder_pipeline_t* pipeline, uint8_t* symbol)
+{
+    assert(pipeline != nullptr);
+    assert(symbol != nullptr);
+
+    packet* p = pipeline->m_packets.write_slot();
+    if (p == nullptr)
+        return 0;
+
+    p->m_command = command::push_front_symbol;
+    p->m_storage = symbol;
+    pipeline->m_packets.commit_write();
+    return 1;
+}
+
+uint8_t kslide_decoder_pipeline_pop_back_symbol(
+    kslide_decoder_pipeline_t* pipeline)
+{
+    assert(pipeline != nullptr);
+
+    packet* p = pipeline->m_packets.write_slot();
+    if (p == nullptr)
+        return 0;
+
+    p->m_command = command::pop_back_symbol;
+    pipeline->m_packets.commit_write();
+    return 1;
+}
+
+uint8_t kslide_decoder_pipeline_read_symbol(
+    kslide_decoder_pipeline_t* pipeline, uint64_t window_lower_bound,
+    uint64_t window_symbols, const uint8_t* symbol,
+    const uint8_t* coefficients, uint64_t coefficient_vector_size)
+{
+    assert(pipeline != nullptr);
+    assert(symbol != nullptr);
+    assert(coefficients != nullptr);
+
+    packet* p = pipeline->m_packets.write_slot();
+    if (p == nullptr)
+        return 0;
+
+    assert(coefficient_vector_size <= p->m_coefficients.capacity());
+    p->m_command = command::read_symbol;
+    p->m_window_lower_bound = window_lower_bound;
+    p->m_window_symbols = window_symbols;
+    memcpy(p->m_symbol.data(), symbol, p->m_symbol.size());
+    p->m_coefficients.resize(coefficient_vector_size);
+    memcpy(p->m_coefficients.data(), coefficients, coefficient_vector_size);
+    pipeline->m_packets.commit_write();
+    return 1;
+}
+
+uint8_t kslide_decoder_pipeline_read_seeded_symbol(
+    kslide_decoder_pipeline_t* pipeline, uint64_t window_lower_bound,
+    uint64_t window_symbols, const uint8_t* symbol, uint64_t seed)
+{
+    assert(pipeline != nullptr);
+    assert(symbol != nullptr);
+
+    packet* p = pipeline->m_packets.write_slot();
+    if (p == nullptr)
+        return 0;
+
+    p->m_command = command::read_seeded_symbol;
+    p->m_window_lower_bound = window_lower_bound;
+    p->m_window_symbols = window_symbols;
+    p->m_seed = seed;
+    memcpy(p->m_symbol.data(), symbol, p->m_symbol.size());
+    pipeline->m_packets.commit_write();
+    return 1;
+}
+
+uint8_t kslide_decoder_pipeline_read_source_symbol(
+    kslide_decoder_pipeline_t* pipeline, const uint8_t* symbol,
+    uint64_t index)
+{
+    assert(pipeline != nullptr);
+    assert(symbol != nullptr);
+
+    packet* p = pipeline->m_packets.write_slot();
+    if (p == nullptr)
+        return 0;
+
+    p->m_command = command::read_source_symbol;
+    p->m_index = index;
+    memcpy(p->m_symbol.data(), symbol, p->m_symbol.size());
+    pipeline->m_packets.commit_write();
+    return 1;
+}
+
+uint8_t kslide_decoder_pipeline_poll(kslide_decoder_pipeline_t* pipeline,
+                                     kslide_pipeline_event* event)
+{
+    assert(pipeline != nullptr);
+    assert(event != nullptr);
+
+    kslide_pipeline_event* next = pipeline->m_events.read_slot();
+    if (next == nullptr)
+        return 0;
+
+    *event = *next;
+    pipeline->m_events.commit_read();
+    return 1;
+}
@@ -0,0 +1,155 @@
+// Copyright Steinwurf ApS 2018.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include "coefficient_codec.hpp"
+#include "kodo_slide_c.h"
+#include "wrappers.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+// The feedback consists of three varints followed by a bitmap:
+//
+//   prefix:  the decoded prefix upper bound of the decoder
+//   symbols: the number of stream symbols from the prefix to the stream
+//            upper bound of the decoder
+//   missing: the number of symbols missing at the decoder
+//   bitmap:  one bit per symbol from the prefix (set if decoded), written
+//            as a binary coefficient vector with the coefficient codec, so
+//            a long tail with few losses is sent as runs
+
+namespace
+{
+const uint64_t max_varint_size = 10;
+}
+
+//------------------------------------------------------------------
+// FEEDBACK API
+//------------------------------------------------------------------
+
+uint64_t kslide_decoder_feedback_max_size(kslide_decoder_t* decoder)
+{
+    assert(decoder != nullptr);
+    return 3 * max_varint_size +
+           kodo_slide_c::max_compressed_size(
+               1, decoder->m_impl.stream_symbols());
+}
+
+uint64_t kslide_decoder_write_feedback(kslide_decoder_t* decoder,
+                                       uint8_t* data)
+{
+    assert(decoder != nullptr);
+    assert(data != nullptr);
+
+    const kodo_slide_c::offset_decoder& impl = decoder->m_impl;
+    uint64_t prefix = kslide_decoder_decoded_prefix_upper_bound(decoder);
+    uint64_t symbols = impl.stream_upper_bound() - prefix;
+
+    uint8_t* output = data;
+    output = kodo_slide_c::write_varint(output, prefix);
+    output = kodo_slide_c::write_varint(output, symbols);
+    output = kodo_slide_c::write_varint(output, impl.symbols_missing());
+
+    // The scratch buffer has at least one byte, so it exists for an empty
+    // bitmap
+    uint64_t bitmap_size = kodo_slide_c::coefficient_vector_size(1, symbols);
+    uint8_t* bitmap =
+        scratch_buffer(*decoder, std::max<uint64_t>(bitmap_size, 1));
+    memset(bitmap, 0, bitmap_size);
+    for (uint64_t i = 0; i < symbols; ++i)
+    {
+        if (impl.is_symbol_decoded(prefix + i))
+            kodo_slide_c::set_value(1, bitmap, i, 1);
+    }
+    output += kodo_slide_c::compress_coefficients(1, symbols, bitmap, output);
+
+    return output - data;
+}
+
+uint64_t kslide_encoder_read_feedback(kslide_encoder_t* encoder,
+                                      const uint8_t* data, uint64_t size)
+{
+    assert(encoder != nullptr);
+    assert(data != nullptr);
+
+    const uint8_t* input = data;
+    const uint8_t* end = data + size;
+
+    uint64_t prefix;
+    uint64_t symbols;
+    uint64_t missing;
+
+    input = kodo_slide_c::read_varint(input, end, prefix);
+    if (input == nullptr)
+        return 0;
+    input = kodo_slide_c::read_varint(input, end, symbols);
+    if (input == nullptr)
+        return 0;
+    input = kodo_slide_c::read_varint(input, end, missing);
+    if (input == nullptr)
+        return 0;
+
+    kodo_slide::encoder& impl = encoder->m_impl;
+
+    // The decoder cannot know of symbols which were never pushed here
+    if (prefix > impl.stream_upper_bound() ||
+        symbols > impl.stream_upper_bound() - prefix)
+    {
+        return 0;
+    }
+
+    // The bitmap is decompressed to the scratch arena first, so invalid
+    // feedback leaves the last feedback untouched
+    uint64_t bitmap_size = kodo_slide_c::coefficient_vector_size(1, symbols);
+    uint8_t* bitmap =
+        scratch_buffer(*encoder, std::max<uint64_t>(bitmap_size, 1));
+    uint64_t read = kodo_slide_c::decompress_coefficients(
+        1, symbols, input, end - input, bitmap);
+    if (read == 0)
+        return 0;
+
+    encoder->m_feedback_prefix = prefix;
+    encoder->m_feedback_symbols = symbols;
+    encoder->m_feedback_missing = missing;
+    encoder->m_feedback_decoded.assign(bitmap, bitmap + bitmap_size);
+    input += read;
+
+    // Pop the acknowledged symbols. The window is moved off a symbol before
+    // it is popped.
+    while (impl.stream_symbols() > 0 && impl.stream_lower_bound() < prefix)
+    {
+        if (impl.window_symbols() > 0 &&
+            impl.window_lower_bound() == impl.stream_lower_bound())
+        {
+            impl.set_window(impl.window_lower_bound() + 1,
+                            impl.window_symbols() - 1);
+        }
+        kslide_encoder_pop_back_symbol(encoder);
+    }
+
+    return input - data;
+}
+
+uint64_t kslide_encoder_feedback_symbols_missing(kslide_encoder_t* encoder)
+{
+    assert(encoder != nullptr);
+    return encoder->m_feedback_missing;
+}
+
+uint8_t kslide_encoder_feedback_is_symbol_decoded(kslide_encoder_t* encoder,
+                                                  uint64_t index)
+{
+    assert(encoder != nullptr);
+
+    if (index < encoder->m_feedback_prefix)
+        return 1;
+
+    uint64_t i = index - encoder->m_feedback_prefix;
+    if (i >= encoder->m_feedback_symbols)
+        return 0;
+
+    return (encoder->m_feedback_decoded[i / 8] >> (i % 8)) & 0x1;
+}
@@ -0,0 +1,125 @@
+// Copyright Steinwurf ApS 2018.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include "allocator.hpp"
+#include "file_sink.hpp"
+#include "kodo_slide_c.h"
+#include "mapped_file.hpp"
+#include "wrappers.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+
+struct kslide_file_sink : kodo_slide_c::allocated
+{
+    kslide_decoder_t* m_decoder;
+    kodo_slide_c::mapped_file m_file;
+    uint64_t m_file_size;
+    uint64_t m_symbol_size;
+
+    /// The stream index of the first symbol of the file
+    uint64_t m_first_index;
+
+    /// The number of symbols of the file which have been pushed
+    uint64_t m_pushed = 0;
+};
+
+kslide_file_sink_t* kslide_new_file_sink(kslide_decoder_t* decoder,
+                                         const char* path, uint64_t file_size)
+{
+    assert(decoder != nullptr);
+    assert(path != nullptr);
+    assert(file_size > 0);
+    assert(decoder->m_file_sink == nullptr);
+
+    uint64_t symbol_size = kslide_decoder_symbol_size(decoder);
+    uint64_t symbols = (file_size + symbol_size - 1) / symbol_size;
+
+    // The file is padded to a whole number of symbols while it is mapped and
+    // truncated to its real size when the sink is deleted
+    auto sink = new kslide_file_sink;
+    if (!sink->m_file.open_write(path, symbols * symbol_size))
+    {
+        delete sink;
+        return nullptr;
+    }
+
+    sink->m_decoder = decoder;
+    sink->m_file_size = file_size;
+    sink->m_symbol_size = symbol_size;
+    sink->m_first_index = kslide_decoder_stream_upper_bound(decoder);
+    decoder->m_file_sink = sink;
+    return sink;
+}
+
+void kslide_delete_file_sink(kslide_file_sink_t* sink)
+{
+    assert(sink != nullptr);
+    sink->m_decoder->m_file_sink = nullptr;
+    sink->m_file.close(sink->m_file_size);
+    delete sink;
+}
+
+uint64_t kslide_file_sink_symbols(kslide_file_sink_t* sink)
+{
+    assert(sink != nullptr);
+    return sink->m_file.size() / sink->m_symbol_size;
+}
+
+uint8_t kslide_file_sink_push_front_symbol(kslide_file_sink_t* sink)
+{
+    return kslide_file_sink_push_front_symbol_with_deadline(sink, UINT64_MAX);
+}
+
+uint8_t kslide_file_sink_push_front_symbol_with_deadline(
+    kslide_file_sink_t* sink, uint64_t deadline)
+{
+    assert(sink != nullptr);
+    assert(kslide_decoder_stream_upper_bound(sink->m_decoder) ==
+           sink->m_first_index + sink->m_pushed);
+
+    if (sink->m_pushed == kslide_file_sink_symbols(sink))
+        return 0;
+
+    uint8_t* symbol =
+        sink->m_file.data() + sink->m_pushed * sink->m_symbol_size;
+    kslide_decoder_push_front_symbol_with_deadline(
+        sink->m_decoder, symbol, deadline);
+    ++sink->m_pushed;
+    return 1;
+}
+
+uint64_t kslide_file_sink_pop_back_symbol(kslide_file_sink_t* sink)
+{
+    assert(sink != nullptr);
+    return kslide_decoder_pop_back_symbol(sink->m_decoder);
+}
+
+namespace kodo_slide_c
+{
+void file_sink_pop(kslide_file_sink& sink, uint64_t index, bool decoded)
+{
+    // The stream may hold symbols which were pushed before the sink was
+    // created. They are not part of the file.
+    if (index < sink.m_first_index ||
+        index - sink.m_first_index >= sink.m_pushed)
+    {
+        return;
+    }
+
+    uint64_t position = index - sink.m_first_index;
+
+    // A symbol which is not decoded may hold a partially decoded symbol.
+    // It is zeroed so the file does not contain coded data.
+    if (!decoded)
+    {
+        uint8_t* symbol = sink.m_file.data() + position * sink.m_symbol_size;
+        memset(symbol, 0, sink.m_symbol_size);
+    }
+
+    sink.m_file.release_below((position + 1) * sink.m_symbol_size);
+}
+}
@@ -0,0 +1,19 @@
+// Copyright Steinwurf ApS 2018.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include "kodo_slide_c.h"
+
+#include <cstdint>
+
+namespace kodo_slide_c
+{
+/// Zeroes the popped symbol in the file if it was not decoded and releases
+/// the pages below it. Called by the decoder after the symbol at index is
+/// popped, so every pop of the decoder, including expiry, goes through the
+/// file sink. Symbols which are not stored in the file are ignored.
+void file_sink_pop(kslide_file_sink& sink, uint64_t index, bool decoded);
+}
@@ -0,0 +1,171 @@
+// Copyright Steinwurf ApS 2018.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include "allocator.hpp"
+#include "file_source.hpp"
+#include "kodo_slide_c.h"
+#include "mapped_file.hpp"
+#include "wrappers.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+
+struct kslide_file_source : kodo_slide_c::allocated
+{
+    kslide_encoder_t* m_encoder;
+    kodo_slide_c::mapped_file m_file;
+    uint64_t m_symbol_size;
+
+    /// The stream index of the first symbol of the file
+    uint64_t m_first_index;
+
+    /// The number of symbols of the file which have been pushed
+    uint64_t m_pushed = 0;
+
+    /// The number of symbols to read ahead of the stream upper bound
+    uint64_t m_readahead = 64;
+
+    /// Zero padded copy of the last symbol if the file size is not a
+    /// multiple of the symbol size
+    kodo_slide_c::vector<uint8_t> m_last_symbol;
+};
+
+namespace
+{
+uint64_t file_source_symbols(const kslide_file_source& source)
+{
+    return (source.m_file.size() + source.m_symbol_size - 1) /
+           source.m_symbol_size;
+}
+
+void file_source_readahead(kslide_file_source& source)
+{
+    source.m_file.will_need(
+        source.m_pushed * source.m_symbol_size,
+        (source.m_pushed + source.m_readahead) * source.m_symbol_size);
+}
+}
+
+kslide_file_source_t* kslide_new_file_source(kslide_encoder_t* encoder,
+                                             const char* path)
+{
+    assert(encoder != nullptr);
+    assert(path != nullptr);
+    assert(encoder->m_file_source == nullptr);
+
+    auto source = new kslide_file_source;
+    if (!source->m_file.open_read(path))
+    {
+        delete source;
+        return nullptr;
+    }
+
+    source->m_encoder = encoder;
+    source->m_symbol_size = kslide_encoder_symbol_size(encoder);
+    source->m_first_index = kslide_encoder_stream_upper_bound(encoder);
+
+    uint64_t file_size = source->m_file.size();
+    uint64_t remainder = file_size % source->m_symbol_size;
+    if (remainder != 0)
+    {
+        // The mapping cannot be read beyond the end of the file, so the last
+        // symbol is copied to a zero padded buffer
+        source->m_last_symbol.resize(source->m_symbol_size, 0);
+        memcpy(source->m_last_symbol.data(),
+               source->m_file.data() + file_size - remainder, remainder);
+    }
+
+    file_source_readahead(*source);
+    encoder->m_file_source = source;
+    return source;
+}
+
+void kslide_delete_file_source(kslide_file_source_t* source)
+{
+    assert(source != nullptr);
+    source->m_encoder->m_file_source = nullptr;
+    delete source;
+}
+
+uint64_t kslide_file_source_symbols(kslide_file_source_t* source)
+{
+    assert(source != nullptr);
+    return file_source_symbols(*source);
+}
+
+uint64_t kslide_file_source_file_size(kslide_file_source_t* source)
+{
+    assert(source != nullptr);
+    return source->m_file.size();
+}
+
+void kslide_file_source_set_readahead(kslide_file_source_t* source,
+                                      uint64_t symbols)
+{
+    assert(source != nullptr);
+    source->m_readahead = symbols;
+}
+
+uint8_t kslide_file_source_push_front_symbol(kslide_file_source_t* source)
+{
+    assert(source != nullptr);
+    assert(kslide_encoder_stream_upper_bound(source->m_encoder) ==
+           source->m_first_index + source->m_pushed);
+
+    uint64_t symbols = file_source_symbols(*source);
+    if (source->m_pushed == symbols)
+        return 0;
+
+    uint8_t* symbol =
+        source->m_file.data() + source->m_pushed * source->m_symbol_size;
+    if (source->m_pushed + 1 == symbols && !source->m_last_symbol.empty())
+    {
+        symbol = source->m_last_symbol.data();
+    }
+
+    kslide_encoder_push_front_symbol(source->m_encoder, symbol);
+    ++source->m_pushed;
+
+    // Advise the kernel of the next range once half of the previous one has
+    // been consumed, rather than on every symbol
+    uint64_t step = std::max<uint64_t>(source->m_readahead / 2, 1);
+    if (source->m_pushed % step == 0)
+    {
+        file_source_readahead(*source);
+    }
+
+    return 1;
+}
+
+uint64_t kslide_file_source_released_size(kslide_file_source_t* source)
+{
+    assert(source != nullptr);
+    return source->m_file.released();
+}
+
+uint64_t kslide_file_source_pop_back_symbol(kslide_file_source_t* source)
+{
+    assert(source != nullptr);
+    return kslide_encoder_pop_back_symbol(source->m_encoder);
+}
+
+namespace kodo_slide_c
+{
+void file_source_pop(kslide_file_source& source, uint64_t index)
+{
+    // The stream may hold symbols which were pushed before the source was
+    // created. They are not part of the file.
+    if (index < source.m_first_index ||
+        index - source.m_first_index >= source.m_pushed)
+    {
+        return;
+    }
+
+    uint64_t popped = index + 1 - source.m_first_index;
+    source.m_file.release_below(popped * source.m_symbol_size);
+}
+}
@@ -0,0 +1,19 @@
+// Copyright Steinwurf ApS 2018.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include "kodo_slide_c.h"
+
+#include <cstdint>
+
+namespace kodo_slide_c
+{
+/// Releases the pages of the file below the popped symbol. Called by the
+/// encoder after the symbol at index is popped, so every pop of the
+/// encoder goes through the file source. Symbols which are not read from
+/// the file are ignored.
+void file_source_pop(kslide_file_source& source, uint64_t index);
+}
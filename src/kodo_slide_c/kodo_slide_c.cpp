@@ -3,41 +3,22 @@
 // See accompanying file LICENSE.rst or
 // http://www.steinwurf.com/licensing
 
+#include "accumulator.hpp"
+#include "coefficient_codec.hpp"
+#include "counter_generator.hpp"
+#include "file_sink.hpp"
+#include "file_source.hpp"
 #include "kodo_slide_c.h"
+#include "wrappers.hpp"
 
 #include <cstring>
 #include <cstdint>
 #include <cassert>
+#include <algorithm>
+#include <deque>
 #include <string>
-
-#include <kodo_slide/encoder.hpp>
-#include <kodo_slide/decoder.hpp>
-
-struct kslide_decoder
-{
-    kslide_decoder(kodo_slide::decoder decoder) :
-        m_impl(decoder)
-    { }
-    kodo_slide::decoder m_impl;
-};
-
-struct kslide_decoder_factory
-{
-    kodo_slide::decoder::factory m_impl;
-};
-
-struct kslide_encoder
-{
-    kslide_encoder(kodo_slide::encoder encoder) :
-        m_impl(encoder)
-    { }
-    kodo_slide::encoder m_impl;
-};
-
-struct kslide_encoder_factory
-{
-    kodo_slide::encoder::factory m_impl;
-};
+#include <utility>
+#include <vector>
 
 int32_t kslide_field_to_c_field(kodo_slide::finite_field field_id)
 {
@@ -120,7 +101,11 @@ kslide_encoder_t* kslide_encoder_factory_build(
     kslide_encoder_factory_t* factory)
 {
     assert(factory != nullptr);
-    return new kslide_encoder_t(factory->m_impl.build());
+    auto encoder = new kslide_encoder_t(
+        factory->m_impl.build(),
+        kslide_field_to_c_field(factory->m_impl.field()));
+    encoder->m_generator = factory->m_generator;
+    return encoder;
 }
 
 void kslide_encoder_factory_initialize(
@@ -128,7 +113,15 @@ void kslide_encoder_factory_initialize(
 {
     assert(factory != nullptr);
     assert(encoder != nullptr);
+    assert(encoder->m_file_source == nullptr);
     factory->m_impl.initialize(encoder->m_impl);
+    encoder->m_field = kslide_field_to_c_field(factory->m_impl.field());
+    encoder->m_generator = factory->m_generator;
+    encoder->m_seed = 0;
+    encoder->m_unaligned_symbols.clear();
+    kslide_encoder_set_accumulators(encoder, 0, 0);
+    reset_feedback(*encoder);
+    encoder->m_work = 0;
 }
 
 void kslide_delete_encoder(kslide_encoder_t* encoder)
@@ -183,7 +176,11 @@ kslide_decoder_t* kslide_decoder_factory_build(
     kslide_decoder_factory_t* factory)
 {
     assert(factory != nullptr);
-    return new kslide_decoder_t(factory->m_impl.build());
+    auto decoder = new kslide_decoder_t(
+        factory->m_impl.build(),
+        kslide_field_to_c_field(factory->m_impl.field()));
+    decoder->m_generator = factory->m_generator;
+    return decoder;
 }
 
 void kslide_decoder_factory_initialize(
@@ -191,7 +188,18 @@ void kslide_decoder_factory_initialize(
 {
     assert(factory != nullptr);
     assert(decoder != nullptr);
-    factory->m_impl.initialize(decoder->m_impl);
+    assert(decoder->m_file_sink == nullptr);
+    factory->m_impl.initialize(decoder->m_impl.decoder());
+    decoder->m_impl.reset_offset();
+    decoder->m_field = kslide_field_to_c_field(factory->m_impl.field());
+    decoder->m_generator = factory->m_generator;
+    decoder->m_seed = 0;
+    decoder->m_symbols.clear();
+    decoder->m_unaligned_symbols = 0;
+    decoder->m_decoded_prefix = 0;
+    decoder->m_work = 0;
+    decoder->m_dropped_reads = 0;
+    decoder->m_pending_reads.clear();
 }
 
 void kslide_delete_decoder(kslide_decoder_t* decoder)
@@ -204,6 +212,23 @@ void kslide_delete_decoder(kslide_decoder_t* decoder)
 // ENCODER API
 //------------------------------------------------------------------
 
+void kslide_encoder_reset(kslide_encoder_t* encoder)
+{
+    assert(encoder != nullptr);
+    assert(encoder->m_file_source == nullptr);
+
+    // The kodo-slide object is initialized again in place
+    kodo_slide::encoder::factory factory;
+    factory.set_field(c_field_to_kslide_field(encoder->m_field));
+    factory.set_symbol_size(encoder->m_impl.symbol_size());
+    factory.initialize(encoder->m_impl);
+    encoder->m_seed = 0;
+    encoder->m_unaligned_symbols.clear();
+    kodo_slide_c::accumulate_reset(*encoder);
+    reset_feedback(*encoder);
+    encoder->m_work = 0;
+}
+
 uint64_t kslide_encoder_symbol_size(kslide_encoder_t* encoder)
 {
     assert(encoder != nullptr);
@@ -233,13 +258,52 @@ uint64_t kslide_encoder_push_front_symbol(kslide_encoder_t* encoder,
 {
     assert(encoder != nullptr);
     assert(data != nullptr);
-    return encoder->m_impl.push_front_symbol(data);
+    uint64_t index = encoder->m_impl.push_front_symbol(data);
+
+    if (!kodo_slide_c::is_aligned(data))
+        encoder->m_unaligned_symbols.push_back(index);
+
+    if (encoder->m_accumulators > 0)
+        kodo_slide_c::accumulate_push(*encoder, index);
+
+    if (encoder->m_track_stream)
+        update_tracked_window(encoder->m_impl);
+    else if (encoder->m_block_symbols > 0)
+        update_block_window(encoder->m_impl, encoder->m_block_symbols);
+
+    if (encoder->m_trace.enabled())
+        encoder->m_trace.record(kslide_trace_push_front_symbol, index,
+                                encoder->m_impl.stream_symbols());
+    return index;
 }
 
 uint64_t kslide_encoder_pop_back_symbol(kslide_encoder_t* encoder)
 {
     assert(encoder != nullptr);
-    return encoder->m_impl.pop_back_symbol();
+
+    if (encoder->m_accumulators > 0)
+        kodo_slide_c::accumulate_pop(*encoder);
+
+    uint64_t index = encoder->m_impl.pop_back_symbol();
+
+    if (encoder->m_file_source != nullptr)
+        kodo_slide_c::file_source_pop(*encoder->m_file_source, index);
+
+    if (!encoder->m_unaligned_symbols.empty() &&
+        encoder->m_unaligned_symbols.front() == index)
+    {
+        encoder->m_unaligned_symbols.pop_front();
+    }
+
+    if (encoder->m_track_stream)
+        update_tracked_window(encoder->m_impl);
+    else if (encoder->m_block_symbols > 0)
+        update_block_window(encoder->m_impl, encoder->m_block_symbols);
+
+    if (encoder->m_trace.enabled())
+        encoder->m_trace.record(kslide_trace_pop_back_symbol, index,
+                                encoder->m_impl.stream_symbols());
+    return index;
 }
 
 uint64_t kslide_encoder_window_symbols(kslide_encoder_t* encoder)
@@ -265,6 +329,24 @@ void kslide_encoder_set_window(kslide_encoder_t* encoder, uint64_t lower_bound,
 {
     assert(encoder != nullptr);
     encoder->m_impl.set_window(lower_bound, symbols);
+    encoder->m_trace.record(kslide_trace_set_window, lower_bound, symbols);
+}
+
+void kslide_encoder_set_track_stream(kslide_encoder_t* encoder,
+                                     uint8_t enabled)
+{
+    assert(encoder != nullptr);
+    assert(!enabled || encoder->m_block_symbols == 0);
+    encoder->m_track_stream = enabled != 0;
+
+    if (encoder->m_track_stream)
+        update_tracked_window(encoder->m_impl);
+}
+
+uint8_t kslide_encoder_track_stream(kslide_encoder_t* encoder)
+{
+    assert(encoder != nullptr);
+    return encoder->m_track_stream;
 }
 
 uint64_t kslide_encoder_coefficient_vector_size(kslide_encoder_t* encoder)
@@ -277,12 +359,23 @@ void kslide_encoder_set_seed(kslide_encoder_t* encoder, uint64_t seed_value)
 {
     assert(encoder != nullptr);
     encoder->m_impl.set_seed(seed_value);
+    encoder->m_seed = seed_value;
 }
 
 void kslide_encoder_generate(kslide_encoder_t* encoder, uint8_t* coefficients)
 {
     assert(encoder != nullptr);
     assert(coefficients != nullptr);
+
+    if (encoder->m_generator == kslide_generator_counter)
+    {
+        kodo_slide_c::generate_counter(
+            kodo_slide_c::field_bits(encoder->m_field), encoder->m_seed,
+            encoder->m_impl.window_lower_bound(), encoder->m_impl.window_symbols(),
+            coefficients);
+        return;
+    }
+
     encoder->m_impl.generate(coefficients);
 }
 
@@ -292,7 +385,25 @@ void kslide_encoder_write_symbol(kslide_encoder_t* encoder, uint8_t* symbol,
     assert(encoder != nullptr);
     assert(symbol != nullptr);
     assert(coefficients != nullptr);
-    encoder->m_impl.write_symbol(symbol, coefficients);
+
+    // Write to an aligned buffer so the kernels only see aligned buffers
+    if (encoder->m_aligned_copy && encoder->m_unaligned_symbols.empty() &&
+        !kodo_slide_c::is_aligned(symbol))
+    {
+        uint64_t symbol_size = encoder->m_impl.symbol_size();
+        uint8_t* aligned = encoder->m_aligned_symbol.buffer(symbol_size);
+        encoder->m_impl.write_symbol(aligned, coefficients);
+        memcpy(symbol, aligned, symbol_size);
+    }
+    else
+    {
+        encoder->m_impl.write_symbol(symbol, coefficients);
+    }
+    encoder->m_work += std::max<uint64_t>(encoder->m_impl.window_symbols(), 1);
+    if (encoder->m_trace.enabled())
+        encoder->m_trace.record(kslide_trace_coded_symbol,
+                                encoder->m_impl.window_lower_bound(),
+                                encoder->m_impl.window_symbols());
 }
 
 void kslide_encoder_write_source_symbol(kslide_encoder_t* encoder,
@@ -301,12 +412,264 @@ void kslide_encoder_write_source_symbol(kslide_encoder_t* encoder,
     assert(encoder != nullptr);
     assert(symbol != nullptr);
     encoder->m_impl.write_source_symbol(symbol, index);
+    encoder->m_work++;
+    encoder->m_trace.record(kslide_trace_source_symbol, index, 1);
 }
 
 //------------------------------------------------------------------
 // DECODER API
 //------------------------------------------------------------------
 
+namespace
+{
+/// Records a symbol read by a decoder in its trace
+void trace_read(kslide_decoder_t* decoder, int32_t type, uint64_t index,
+                uint64_t symbols, uint64_t rank_before)
+{
+    if (!decoder->m_trace.enabled())
+        return;
+
+    uint64_t rank = decoder->m_impl.rank();
+    decoder->m_trace.record(
+        type, index, symbols, rank,
+        kslide_decoder_decoded_prefix_upper_bound(decoder),
+        rank > rank_before ? 1 : 0);
+}
+
+/// @return An aligned copy of an unaligned symbol if the aligned copy is
+///         enabled and the stream symbols are aligned. Otherwise the symbol.
+uint8_t* aligned_symbol(kslide_decoder_t* decoder, uint8_t* symbol)
+{
+    if (!decoder->m_aligned_copy || decoder->m_unaligned_symbols > 0 ||
+        kodo_slide_c::is_aligned(symbol))
+        return symbol;
+
+    uint64_t symbol_size = decoder->m_impl.symbol_size();
+    uint8_t* aligned = decoder->m_aligned_symbol.buffer(symbol_size);
+    memcpy(aligned, symbol, symbol_size);
+    return aligned;
+}
+
+void read_symbol_now(kslide_decoder_t* decoder, uint8_t* symbol,
+                     uint8_t* coefficients)
+{
+    symbol = aligned_symbol(decoder, symbol);
+    uint64_t rank = decoder->m_trace.enabled() ? decoder->m_impl.rank() : 0;
+    decoder->m_impl.read_symbol(symbol, coefficients);
+    decoder->m_work += std::max<uint64_t>(decoder->m_impl.window_symbols(), 1);
+    trace_read(decoder, kslide_trace_coded_symbol,
+               decoder->m_impl.window_lower_bound(),
+               decoder->m_impl.window_symbols(), rank);
+}
+
+void read_source_symbol_now(kslide_decoder_t* decoder, uint8_t* symbol,
+                            uint64_t index)
+{
+    symbol = aligned_symbol(decoder, symbol);
+    uint64_t rank = decoder->m_trace.enabled() ? decoder->m_impl.rank() : 0;
+    decoder->m_impl.read_source_symbol(symbol, index);
+    decoder->m_work++;
+    trace_read(decoder, kslide_trace_source_symbol, index, 1, rank);
+}
+
+/// Copies a coded read to the back of the pending reads
+void queue_read(kslide_decoder_t* decoder, const uint8_t* symbol,
+                const uint8_t* coefficients)
+{
+    kodo_slide_c::offset_decoder& impl = decoder->m_impl;
+
+    pending_read& read = decoder->m_pending_reads.push_back_slot();
+    read.m_window_lower_bound = impl.window_lower_bound();
+    read.m_window_symbols = impl.window_symbols();
+    memcpy(read.m_symbol.buffer(impl.symbol_size()), symbol,
+           impl.symbol_size());
+    read.m_coefficients.assign(
+        coefficients, coefficients + impl.coefficient_vector_size());
+}
+
+/// @return The work of a read, i.e. the number of symbols it covers
+uint64_t read_work(const pending_read& read)
+{
+    return std::max<uint64_t>(read.m_window_symbols, 1);
+}
+
+/// Applies the oldest pending read in the window it was read in
+void apply_read(kslide_decoder_t* decoder)
+{
+    kodo_slide_c::offset_decoder& impl = decoder->m_impl;
+    pending_read& read = decoder->m_pending_reads.front();
+
+    uint64_t window_lower_bound = impl.window_lower_bound();
+    uint64_t window_symbols = impl.window_symbols();
+
+    impl.set_window(read.m_window_lower_bound, read.m_window_symbols);
+    read_symbol_now(decoder, read.m_symbol.m_buffer,
+                    read.m_coefficients.data());
+    impl.set_window(window_lower_bound, window_symbols);
+
+    decoder->m_pending_reads.pop_front();
+}
+
+/// Discards the oldest pending read and counts it as dropped
+void drop_read(kslide_decoder_t* decoder)
+{
+    decoder->m_pending_reads.pop_front();
+    decoder->m_dropped_reads++;
+}
+
+/// @return True if the work of a read exceeds the whole work quota, i.e.
+///         the read would not fit in any period
+bool exceeds_quota(kslide_decoder_t* decoder, uint64_t work)
+{
+    return decoder->m_work_quota > 0 && work > decoder->m_work_quota;
+}
+
+/// Drops the oldest pending reads as long as they exceed the whole work
+/// quota, so they do not hold up the reads behind them
+void drop_oversized_reads(kslide_decoder_t* decoder)
+{
+    while (!decoder->m_pending_reads.empty() &&
+           exceeds_quota(decoder, read_work(decoder->m_pending_reads.front())))
+    {
+        drop_read(decoder);
+    }
+}
+
+/// @return True if the work of the oldest pending read fits in what is
+///         left of the work quota
+bool fits_quota(kslide_decoder_t* decoder)
+{
+    return read_work(decoder->m_pending_reads.front()) <=
+           kslide_decoder_work_left(decoder);
+}
+
+/// Applies the pending reads in order as long as their work fits in the
+/// budget and in the work quota
+/// @param spent The work already spent of the budget
+void apply_reads(kslide_decoder_t* decoder, uint64_t budget, uint64_t spent)
+{
+    drop_oversized_reads(decoder);
+    while (!decoder->m_pending_reads.empty())
+    {
+        uint64_t work = read_work(decoder->m_pending_reads.front());
+        if (spent + work > budget || !fits_quota(decoder))
+            return;
+
+        apply_read(decoder);
+        spent += work;
+        drop_oversized_reads(decoder);
+    }
+}
+
+/// @return The work allowed for the reads of a single call
+uint64_t read_allowance(kslide_decoder_t* decoder)
+{
+    return decoder->m_read_budget > 0 ? decoder->m_read_budget : UINT64_MAX;
+}
+
+/// Queues a coded read and applies the pending reads which fit. A read
+/// which exceeds the whole work quota is dropped right away. If the queue
+/// is full the oldest read is applied to make room if the quota allows it,
+/// otherwise the new read is dropped.
+void read_later(kslide_decoder_t* decoder, const uint8_t* symbol,
+                const uint8_t* coefficients)
+{
+    uint64_t work = std::max<uint64_t>(decoder->m_impl.window_symbols(), 1);
+    if (exceeds_quota(decoder, work))
+    {
+        decoder->m_dropped_reads++;
+        return;
+    }
+
+    drop_oversized_reads(decoder);
+    if (decoder->m_pending_reads.size() >= decoder->m_max_pending_reads)
+    {
+        if (!fits_quota(decoder))
+        {
+            decoder->m_dropped_reads++;
+            return;
+        }
+        apply_read(decoder);
+    }
+
+    queue_read(decoder, symbol, coefficients);
+    apply_reads(decoder, read_allowance(decoder), 0);
+}
+
+/// Applies the pending reads which involve the symbol at the back of the
+/// stream, together with the reads before them. The reads which do not fit
+/// in the work quota are dropped.
+void apply_reads_before_pop(kslide_decoder_t* decoder)
+{
+    uint64_t index = decoder->m_impl.stream_lower_bound();
+    uint64_t count = 0;
+
+    for (uint64_t i = 0; i < decoder->m_pending_reads.size(); ++i)
+    {
+        const pending_read& read = decoder->m_pending_reads[i];
+        if (read.m_window_lower_bound == index && read.m_window_symbols > 0)
+            count = i + 1;
+    }
+
+    for (uint64_t i = 0; i < count; ++i)
+    {
+        if (fits_quota(decoder))
+            apply_read(decoder);
+        else
+            drop_read(decoder);
+    }
+}
+
+/// Drops the pending reads whose window lies entirely below the given
+/// stream index, without applying them
+void drop_reads_below(kslide_decoder_t* decoder, uint64_t index)
+{
+    kodo_slide_c::ring<pending_read>& reads = decoder->m_pending_reads;
+
+    uint64_t kept = 0;
+    for (uint64_t i = 0; i < reads.size(); ++i)
+    {
+        if (reads[i].m_window_lower_bound + reads[i].m_window_symbols <= index)
+            continue;
+
+        // Swap rather than move, so the dropped reads leave their buffers
+        // in the slots for reuse
+        if (kept != i)
+            std::swap(reads[kept], reads[i]);
+        ++kept;
+    }
+
+    decoder->m_dropped_reads += reads.size() - kept;
+    reads.pop_back(reads.size() - kept);
+}
+
+/// Discards the pending reads
+void clear_reads(kslide_decoder_t* decoder)
+{
+    decoder->m_pending_reads.clear();
+}
+}
+
+void kslide_decoder_reset(kslide_decoder_t* decoder)
+{
+    assert(decoder != nullptr);
+    assert(decoder->m_file_sink == nullptr);
+
+    // The kodo-slide object is initialized again in place
+    kodo_slide::decoder::factory factory;
+    factory.set_field(c_field_to_kslide_field(decoder->m_field));
+    factory.set_symbol_size(decoder->m_impl.symbol_size());
+    factory.initialize(decoder->m_impl.decoder());
+    decoder->m_impl.reset_offset();
+    decoder->m_seed = 0;
+    decoder->m_symbols.clear();
+    decoder->m_unaligned_symbols = 0;
+    decoder->m_decoded_prefix = 0;
+    decoder->m_work = 0;
+    decoder->m_dropped_reads = 0;
+    clear_reads(decoder);
+}
+
 uint64_t kslide_decoder_symbol_size(kslide_decoder_t* decoder)
 {
     assert(decoder != nullptr);
@@ -333,16 +696,83 @@ uint64_t kslide_decoder_stream_upper_bound(kslide_decoder_t* decoder)
 
 uint64_t kslide_decoder_push_front_symbol(kslide_decoder_t* decoder,
                                           uint8_t* symbol)
+{
+    return kslide_decoder_push_front_symbol_with_deadline(
+        decoder, symbol, UINT64_MAX);
+}
+
+uint64_t kslide_decoder_push_front_symbol_with_deadline(
+    kslide_decoder_t* decoder, uint8_t* symbol, uint64_t deadline)
 {
     assert(decoder != nullptr);
     assert(symbol != nullptr);
-    return decoder->m_impl.push_front_symbol(symbol);
+    decoder->m_symbols.push_back({symbol, deadline});
+    decoder->m_unaligned_symbols += !kodo_slide_c::is_aligned(symbol);
+    uint64_t index = decoder->m_impl.push_front_symbol(symbol);
+
+    if (decoder->m_track_stream)
+        update_tracked_window(decoder->m_impl);
+
+    if (decoder->m_trace.enabled())
+        decoder->m_trace.record(kslide_trace_push_front_symbol, index,
+                                decoder->m_impl.stream_symbols(),
+                                decoder->m_impl.rank());
+    return index;
 }
 
 uint64_t kslide_decoder_pop_back_symbol(kslide_decoder_t* decoder)
 {
     assert(decoder != nullptr);
-    return decoder->m_impl.pop_back_symbol();
+    assert(!decoder->m_symbols.empty());
+
+    if (!decoder->m_pending_reads.empty())
+        apply_reads_before_pop(decoder);
+
+    bool decoded = decoder->m_file_sink != nullptr &&
+                   decoder->m_impl.is_symbol_decoded(
+                       decoder->m_impl.stream_lower_bound());
+
+    decoder->m_unaligned_symbols -=
+        !kodo_slide_c::is_aligned(decoder->m_symbols.front().m_data);
+    decoder->m_symbols.pop_front();
+    uint64_t index = decoder->m_impl.pop_back_symbol();
+
+    if (decoder->m_file_sink != nullptr)
+        kodo_slide_c::file_sink_pop(*decoder->m_file_sink, index, decoded);
+
+    if (decoder->m_track_stream)
+        update_tracked_window(decoder->m_impl);
+
+    if (decoder->m_trace.enabled())
+        decoder->m_trace.record(kslide_trace_pop_back_symbol, index,
+                                decoder->m_impl.stream_symbols(),
+                                decoder->m_impl.rank());
+    return index;
+}
+
+uint64_t kslide_decoder_expire(kslide_decoder_t* decoder, uint64_t now)
+{
+    assert(decoder != nullptr);
+
+    uint64_t expired = 0;
+    while (expired < decoder->m_symbols.size() &&
+           decoder->m_symbols[expired].m_deadline <= now)
+    {
+        ++expired;
+    }
+
+    // The reads which only involve expired symbols are worthless, so they
+    // are dropped rather than applied by the pops
+    if (expired > 0 && !decoder->m_pending_reads.empty())
+    {
+        drop_reads_below(
+            decoder, decoder->m_impl.stream_lower_bound() + expired);
+    }
+
+    for (uint64_t i = 0; i < expired; ++i)
+        kslide_decoder_pop_back_symbol(decoder);
+
+    return expired;
 }
 
 uint64_t kslide_decoder_window_symbols(kslide_decoder_t* decoder)
@@ -368,6 +798,26 @@ void kslide_decoder_set_window(kslide_decoder_t* decoder,
 {
     assert(decoder != nullptr);
     decoder->m_impl.set_window(window_offset, window_symbols);
+    if (decoder->m_trace.enabled())
+        decoder->m_trace.record(kslide_trace_set_window, window_offset,
+                                window_symbols, decoder->m_impl.rank());
+}
+
+void kslide_decoder_set_track_stream(kslide_decoder_t* decoder,
+                                     uint8_t enabled)
+{
+    assert(decoder != nullptr);
+    assert(!enabled || decoder->m_block_symbols == 0);
+    decoder->m_track_stream = enabled != 0;
+
+    if (decoder->m_track_stream)
+        update_tracked_window(decoder->m_impl);
+}
+
+uint8_t kslide_decoder_track_stream(kslide_decoder_t* decoder)
+{
+    assert(decoder != nullptr);
+    return decoder->m_track_stream;
 }
 
 uint64_t kslide_decoder_coefficient_vector_size(kslide_decoder_t* decoder)
@@ -380,12 +830,23 @@ void kslide_decoder_set_seed(kslide_decoder_t* decoder, uint64_t seed_value)
 {
     assert(decoder != nullptr);
     decoder->m_impl.set_seed(seed_value);
+    decoder->m_seed = seed_value;
 }
 
 void kslide_decoder_generate(kslide_decoder_t* decoder, uint8_t* coefficients)
 {
     assert(decoder != nullptr);
     assert(coefficients != nullptr);
+
+    if (decoder->m_generator == kslide_generator_counter)
+    {
+        kodo_slide_c::generate_counter(
+            kodo_slide_c::field_bits(decoder->m_field), decoder->m_seed,
+            decoder->m_impl.window_lower_bound(), decoder->m_impl.window_symbols(),
+            coefficients);
+        return;
+    }
+
     decoder->m_impl.generate(coefficients);
 }
 
@@ -395,7 +856,14 @@ void kslide_decoder_read_symbol(kslide_decoder_t* decoder, uint8_t* symbol,
     assert(decoder != nullptr);
     assert(symbol != nullptr);
     assert(coefficients != nullptr);
-    decoder->m_impl.read_symbol(symbol, coefficients);
+
+    if (decoder->m_read_budget == 0 && decoder->m_work_quota == 0)
+    {
+        read_symbol_now(decoder, symbol, coefficients);
+        return;
+    }
+
+    read_later(decoder, symbol, coefficients);
 }
 
 void kslide_decoder_read_source_symbol(kslide_decoder_t* decoder,
@@ -403,7 +871,10 @@ void kslide_decoder_read_source_symbol(kslide_decoder_t* decoder,
 {
     assert(decoder != nullptr);
     assert(symbol != nullptr);
-    decoder->m_impl.read_source_symbol(symbol, index);
+
+    // Source symbols are essential and cheap, so they are applied right
+    // away and never wait behind the pending coded reads
+    read_source_symbol_now(decoder, symbol, index);
 }
 
 uint64_t kslide_decoder_rank(kslide_decoder_t* decoder)
@@ -436,3 +907,483 @@ uint8_t kslide_decoder_is_symbol_decoded(kslide_decoder_t* decoder,
     assert(decoder != nullptr);
     return decoder->m_impl.is_symbol_decoded(index);
 }
+
+uint64_t kslide_decoder_decoded_prefix_upper_bound(kslide_decoder_t* decoder)
+{
+    assert(decoder != nullptr);
+
+    const kodo_slide_c::offset_decoder& impl = decoder->m_impl;
+    uint64_t& prefix = decoder->m_decoded_prefix;
+
+    if (prefix < impl.stream_lower_bound())
+        prefix = impl.stream_lower_bound();
+
+    while (prefix < impl.stream_upper_bound() && impl.is_symbol_decoded(prefix))
+        ++prefix;
+
+    return prefix;
+}
+
+//------------------------------------------------------------------
+// DECODER SNAPSHOT API
+//------------------------------------------------------------------
+
+namespace
+{
+// The snapshot starts with a fixed size header followed by a bitmap with one
+// bit per stream symbol (set if the symbol is decoded) padded to a multiple
+// of 8 bytes. The data of the decoded symbols follows the bitmap in stream
+// order. All fields are stored in the native byte order.
+const uint32_t snapshot_magic = 0x4b53534e; // "KSSN"
+const uint32_t snapshot_version = 1;
+
+struct snapshot_header
+{
+    uint32_t m_magic;
+    uint32_t m_version;
+    uint64_t m_symbol_size;
+    uint64_t m_stream_lower_bound;
+    uint64_t m_stream_symbols;
+    uint64_t m_window_lower_bound;
+    uint64_t m_window_symbols;
+    uint64_t m_symbols_decoded;
+};
+
+uint64_t snapshot_bitmap_size(uint64_t stream_symbols)
+{
+    return ((stream_symbols + 63) / 64) * 8;
+}
+
+/// Copies the header out of a snapshot, which may not be aligned
+snapshot_header read_snapshot_header(const uint8_t* snapshot)
+{
+    assert(snapshot != nullptr);
+    snapshot_header header;
+    memcpy(&header, snapshot, sizeof(snapshot_header));
+    assert(header.m_magic == snapshot_magic);
+    return header;
+}
+}
+
+uint64_t kslide_decoder_snapshot_size(kslide_decoder_t* decoder)
+{
+    assert(decoder != nullptr);
+
+    const kodo_slide_c::offset_decoder& impl = decoder->m_impl;
+    uint64_t decoded = 0;
+    for (uint64_t i = 0; i < impl.stream_symbols(); ++i)
+    {
+        decoded += impl.is_symbol_decoded(impl.stream_lower_bound() + i);
+    }
+
+    return sizeof(snapshot_header) +
+           snapshot_bitmap_size(impl.stream_symbols()) +
+           decoded * impl.symbol_size();
+}
+
+void kslide_decoder_snapshot(kslide_decoder_t* decoder, uint8_t* snapshot)
+{
+    assert(decoder != nullptr);
+    assert(snapshot != nullptr);
+
+    const kodo_slide_c::offset_decoder& impl = decoder->m_impl;
+    assert(decoder->m_symbols.size() == impl.stream_symbols());
+
+    snapshot_header header;
+    header.m_magic = snapshot_magic;
+    header.m_version = snapshot_version;
+    header.m_symbol_size = impl.symbol_size();
+    header.m_stream_lower_bound = impl.stream_lower_bound();
+    header.m_stream_symbols = impl.stream_symbols();
+    header.m_window_lower_bound = impl.window_lower_bound();
+    header.m_window_symbols = impl.window_symbols();
+    header.m_symbols_decoded = 0;
+
+    uint64_t bitmap_size = snapshot_bitmap_size(header.m_stream_symbols);
+    uint8_t* bitmap = snapshot + sizeof(snapshot_header);
+    uint8_t* data = bitmap + bitmap_size;
+    memset(bitmap, 0, bitmap_size);
+
+    for (uint64_t i = 0; i < header.m_stream_symbols; ++i)
+    {
+        if (!impl.is_symbol_decoded(header.m_stream_lower_bound + i))
+            continue;
+
+        bitmap[i / 8] |= 1U << (i % 8);
+        memcpy(data, decoder->m_symbols[i].m_data, header.m_symbol_size);
+        data += header.m_symbol_size;
+        ++header.m_symbols_decoded;
+    }
+
+    memcpy(snapshot, &header, sizeof(snapshot_header));
+}
+
+uint64_t kslide_decoder_snapshot_stream_lower_bound(const uint8_t* snapshot)
+{
+    return read_snapshot_header(snapshot).m_stream_lower_bound;
+}
+
+uint64_t kslide_decoder_snapshot_stream_symbols(const uint8_t* snapshot)
+{
+    return read_snapshot_header(snapshot).m_stream_symbols;
+}
+
+uint8_t kslide_decoder_restore(kslide_decoder_t* decoder,
+                               const uint8_t* snapshot, uint64_t size,
+                               uint8_t** symbols)
+{
+    assert(decoder != nullptr);
+    assert(snapshot != nullptr);
+
+    kodo_slide_c::offset_decoder& impl = decoder->m_impl;
+
+    if (size < sizeof(snapshot_header))
+        return 0;
+
+    snapshot_header header;
+    memcpy(&header, snapshot, sizeof(snapshot_header));
+
+    if (header.m_magic != snapshot_magic ||
+        header.m_version != snapshot_version ||
+        header.m_symbol_size != impl.symbol_size() ||
+        impl.stream_symbols() != 0 ||
+        impl.stream_lower_bound() > header.m_stream_lower_bound)
+    {
+        return 0;
+    }
+
+    // Everything the restore reads must be inside the buffer, and the
+    // window must be inside the stream, before the decoder is touched
+    uint64_t remaining = size - sizeof(snapshot_header);
+    if (header.m_stream_symbols > remaining * 8 ||
+        snapshot_bitmap_size(header.m_stream_symbols) > remaining ||
+        header.m_stream_symbols > UINT64_MAX - header.m_stream_lower_bound ||
+        header.m_window_lower_bound < header.m_stream_lower_bound ||
+        header.m_window_symbols > header.m_stream_lower_bound +
+                                      header.m_stream_symbols -
+                                      header.m_window_lower_bound)
+    {
+        return 0;
+    }
+
+    const uint8_t* bitmap = snapshot + sizeof(snapshot_header);
+    remaining -= snapshot_bitmap_size(header.m_stream_symbols);
+
+    uint64_t decoded = 0;
+    for (uint64_t i = 0; i < header.m_stream_symbols; ++i)
+        decoded += (bitmap[i / 8] >> (i % 8)) & 1U;
+
+    if (decoded != header.m_symbols_decoded ||
+        decoded > remaining / header.m_symbol_size)
+    {
+        return 0;
+    }
+
+    assert(symbols != nullptr || header.m_stream_symbols == 0);
+
+    // Move the empty stream to the lower bound of the snapshot
+    impl.set_stream_lower_bound(header.m_stream_lower_bound);
+    uint8_t* temp = scratch_buffer(*decoder, header.m_symbol_size);
+
+    const uint8_t* data =
+        bitmap + snapshot_bitmap_size(header.m_stream_symbols);
+
+    for (uint64_t i = 0; i < header.m_stream_symbols; ++i)
+    {
+        assert(symbols[i] != nullptr);
+        decoder->m_symbols.push_back({symbols[i], UINT64_MAX});
+        decoder->m_unaligned_symbols += !kodo_slide_c::is_aligned(symbols[i]);
+        impl.push_front_symbol(symbols[i]);
+    }
+
+    for (uint64_t i = 0; i < header.m_stream_symbols; ++i)
+    {
+        if (!(bitmap[i / 8] & (1U << (i % 8))))
+            continue;
+
+        memcpy(temp, data, header.m_symbol_size);
+        impl.read_source_symbol(temp, header.m_stream_lower_bound + i);
+        data += header.m_symbol_size;
+    }
+
+    impl.set_window(header.m_window_lower_bound, header.m_window_symbols);
+    return 1;
+}
+
+//------------------------------------------------------------------
+// SCRATCH API
+//------------------------------------------------------------------
+
+kslide_scratch_t* kslide_new_scratch()
+{
+    return new kslide_scratch;
+}
+
+void kslide_delete_scratch(kslide_scratch_t* scratch)
+{
+    assert(scratch != nullptr);
+    delete scratch;
+}
+
+uint64_t kslide_scratch_size(kslide_scratch_t* scratch)
+{
+    assert(scratch != nullptr);
+    return scratch->m_size;
+}
+
+void kslide_encoder_set_scratch(kslide_encoder_t* encoder,
+                                kslide_scratch_t* scratch)
+{
+    assert(encoder != nullptr);
+    encoder->m_scratch = scratch;
+}
+
+void kslide_decoder_set_scratch(kslide_decoder_t* decoder,
+                                kslide_scratch_t* scratch)
+{
+    assert(decoder != nullptr);
+    decoder->m_scratch = scratch;
+}
+
+//------------------------------------------------------------------
+// ENCODER BATCH API
+//------------------------------------------------------------------
+
+void kslide_encoders_write_symbols(kslide_encoder_t** encoders,
+                                   uint64_t count, uint8_t** symbols,
+                                   const uint8_t* coefficients)
+{
+    assert(encoders != nullptr);
+    assert(symbols != nullptr);
+    assert(coefficients != nullptr);
+
+    for (uint64_t i = 0; i < count; ++i)
+    {
+        assert(encoders[i] != nullptr);
+        assert(symbols[i] != nullptr);
+        assert(encoders[i]->m_field == encoders[0]->m_field);
+        assert(encoders[i]->m_impl.symbol_size() ==
+               encoders[0]->m_impl.symbol_size());
+        assert(encoders[i]->m_impl.window_symbols() ==
+               encoders[0]->m_impl.window_symbols());
+
+        kslide_encoder_write_symbol(encoders[i], symbols[i], coefficients);
+    }
+}
+
+void kslide_encoders_write_seeded_symbols(kslide_encoder_t** encoders,
+                                          uint64_t count, uint8_t** symbols,
+                                          uint64_t seed)
+{
+    assert(encoders != nullptr);
+
+    if (count == 0)
+        return;
+
+    kslide_encoder_t* first = encoders[0];
+    assert(first != nullptr);
+
+    for (uint64_t i = 0; i < count; ++i)
+    {
+        assert(encoders[i] != nullptr);
+        assert(encoders[i]->m_generator == first->m_generator);
+        assert(first->m_generator != kslide_generator_counter ||
+               encoders[i]->m_impl.window_lower_bound() ==
+                   first->m_impl.window_lower_bound());
+    }
+
+    uint8_t* coefficients =
+        scratch_buffer(*first, first->m_impl.coefficient_vector_size());
+
+    kslide_encoder_set_seed(first, seed);
+    kslide_encoder_generate(first, coefficients);
+
+    kslide_encoders_write_symbols(encoders, count, symbols, coefficients);
+}
+
+//------------------------------------------------------------------
+// DECODER READ BUDGET API
+//------------------------------------------------------------------
+
+void kslide_decoder_set_read_budget(kslide_decoder_t* decoder,
+                                    uint64_t budget)
+{
+    assert(decoder != nullptr);
+    decoder->m_read_budget = budget;
+    apply_reads(decoder, read_allowance(decoder), 0);
+}
+
+uint64_t kslide_decoder_read_budget(kslide_decoder_t* decoder)
+{
+    assert(decoder != nullptr);
+    return decoder->m_read_budget;
+}
+
+uint64_t kslide_decoder_step(kslide_decoder_t* decoder, uint64_t budget)
+{
+    assert(decoder != nullptr);
+
+    drop_oversized_reads(decoder);
+    if (decoder->m_pending_reads.empty())
+        return 0;
+
+    // The oldest read is applied even if it exceeds the budget so the
+    // decoder makes progress, but never beyond the work quota
+    if (!fits_quota(decoder))
+        return decoder->m_pending_reads.size();
+
+    uint64_t work = read_work(decoder->m_pending_reads.front());
+    apply_read(decoder);
+    apply_reads(decoder, budget, work);
+
+    return decoder->m_pending_reads.size();
+}
+
+uint64_t kslide_decoder_pending_reads(kslide_decoder_t* decoder)
+{
+    assert(decoder != nullptr);
+    return decoder->m_pending_reads.size();
+}
+
+void kslide_decoder_set_max_pending_reads(kslide_decoder_t* decoder,
+                                          uint64_t max_reads)
+{
+    assert(decoder != nullptr);
+    assert(max_reads > 0);
+    decoder->m_max_pending_reads = max_reads;
+}
+
+uint64_t kslide_decoder_max_pending_reads(kslide_decoder_t* decoder)
+{
+    assert(decoder != nullptr);
+    return decoder->m_max_pending_reads;
+}
+
+uint64_t kslide_decoder_dropped_reads(kslide_decoder_t* decoder)
+{
+    assert(decoder != nullptr);
+    return decoder->m_dropped_reads;
+}
+
+//------------------------------------------------------------------
+// WORK ACCOUNTING API
+//------------------------------------------------------------------
+
+uint64_t kslide_encoder_work(kslide_encoder_t* encoder)
+{
+    assert(encoder != nullptr);
+    return encoder->m_work;
+}
+
+void kslide_encoder_reset_work(kslide_encoder_t* encoder)
+{
+    assert(encoder != nullptr);
+    encoder->m_work = 0;
+}
+
+void kslide_encoder_set_work_quota(kslide_encoder_t* encoder, uint64_t quota)
+{
+    assert(encoder != nullptr);
+    encoder->m_work_quota = quota;
+}
+
+uint64_t kslide_encoder_work_quota(kslide_encoder_t* encoder)
+{
+    assert(encoder != nullptr);
+    return encoder->m_work_quota;
+}
+
+uint64_t kslide_encoder_work_left(kslide_encoder_t* encoder)
+{
+    assert(encoder != nullptr);
+    if (encoder->m_work_quota == 0)
+        return UINT64_MAX;
+
+    return encoder->m_work_quota > encoder->m_work
+               ? encoder->m_work_quota - encoder->m_work
+               : 0;
+}
+
+uint64_t kslide_decoder_work(kslide_decoder_t* decoder)
+{
+    assert(decoder != nullptr);
+    return decoder->m_work;
+}
+
+void kslide_decoder_reset_work(kslide_decoder_t* decoder)
+{
+    assert(decoder != nullptr);
+    decoder->m_work = 0;
+    apply_reads(decoder, read_allowance(decoder), 0);
+}
+
+void kslide_decoder_set_work_quota(kslide_decoder_t* decoder, uint64_t quota)
+{
+    assert(decoder != nullptr);
+    decoder->m_work_quota = quota;
+    apply_reads(decoder, read_allowance(decoder), 0);
+}
+
+uint64_t kslide_decoder_work_quota(kslide_decoder_t* decoder)
+{
+    assert(decoder != nullptr);
+    return decoder->m_work_quota;
+}
+
+uint64_t kslide_decoder_work_left(kslide_decoder_t* decoder)
+{
+    assert(decoder != nullptr);
+    if (decoder->m_work_quota == 0)
+        return UINT64_MAX;
+
+    return decoder->m_work_quota > decoder->m_work
+               ? decoder->m_work_quota - decoder->m_work
+               : 0;
+}
+
+//------------------------------------------------------------------
+// ALIGNMENT API
+//------------------------------------------------------------------
+
+uint64_t kslide_preferred_alignment()
+{
+    return kodo_slide_c::preferred_alignment;
+}
+
+uint8_t kslide_encoder_is_aligned(kslide_encoder_t* encoder)
+{
+    assert(encoder != nullptr);
+    return encoder->m_unaligned_symbols.empty();
+}
+
+uint8_t kslide_decoder_is_aligned(kslide_decoder_t* decoder)
+{
+    assert(decoder != nullptr);
+    return decoder->m_unaligned_symbols == 0;
+}
+
+void kslide_encoder_set_aligned_copy(kslide_encoder_t* encoder,
+                                     uint8_t enabled)
+{
+    assert(encoder != nullptr);
+    encoder->m_aligned_copy = enabled != 0;
+}
+
+uint8_t kslide_encoder_aligned_copy(kslide_encoder_t* encoder)
+{
+    assert(encoder != nullptr);
+    return encoder->m_aligned_copy;
+}
+
+void kslide_decoder_set_aligned_copy(kslide_decoder_t* decoder,
+                                     uint8_t enabled)
+{
+    assert(decoder != nullptr);
+    decoder->m_aligned_copy = enabled != 0;
+}
+
+uint8_t kslide_decoder_aligned_copy(kslide_decoder_t* decoder)
+{
+    assert(decoder != nullptr);
+    return decoder->m_aligned_copy;
+}
@@ -102,7 +102,8 @@ kslide_encoder_t* kslide_encoder_factory_build(
 
 /// @param factory The factory to initialize the encoder
 /// @param encoder Initialize a encoder with the factory settings. After
-///        calling initialize the encoder will be ready for use.
+///        calling initialize the encoder will be ready for use. It must
+///        not have a file source, see kslide_new_file_source(...).
 KODO_SLIDE_API
 void kslide_encoder_factory_initialize(
     kslide_encoder_factory_t* factory, kslide_encoder_t* encoder);
@@ -157,7 +158,8 @@ kslide_decoder_t* kslide_decoder_factory_build(
 
 /// @param factory The factory to initialize the decoder
 /// @param decoder Initialize a decoder with the factory settings. After
-///        calling initialize the decoder will be ready for use.
+///        calling initialize the decoder will be ready for use. It must
+///        not have a file sink, see kslide_new_file_sink(...).
 KODO_SLIDE_API
 void kslide_decoder_factory_initialize(
     kslide_decoder_factory_t* factory, kslide_decoder_t* decoder);
@@ -171,6 +173,20 @@ void kslide_delete_decoder(kslide_decoder_t* decoder);
 // ENCODER API
 //------------------------------------------------------------------
 
+/// Resets the encoder for a new stream, as if it was just built with the
+/// same field and symbol size. The stream and the window are emptied and
+/// the stream indices start from zero again. The buffers allocated through
+/// kslide_set_allocator() are kept, so once a recycled encoder has seen a
+/// flow, later flows which are no larger do not allocate through it. The
+/// kodo-slide encoder is initialized again in place, and whether it keeps its
+/// own memory is up to kodo-slide. Settings such as
+/// kslide_encoder_set_track_stream() and the scratch arena are kept. An
+/// encoder with a file source must not be reset, since the source refers
+/// to its stream, see kslide_delete_file_source(...).
+/// @param encoder The encoder to reset
+KODO_SLIDE_API
+void kslide_encoder_reset(kslide_encoder_t* encoder);
+
 /// @param encoder The encoder to query
 /// @return The size of a symbol in the stream in bytes.
 KODO_SLIDE_API
@@ -259,6 +275,23 @@ KODO_SLIDE_API
 void kslide_encoder_set_window(kslide_encoder_t* encoder,
                                uint64_t lower_bound, uint64_t symbols);
 
+/// Enable or disable tracking of the stream. While enabled the window
+/// automatically covers the entire stream, i.e. it is updated on every
+/// kslide_encoder_push_front_symbol(...) and
+/// kslide_encoder_pop_back_symbol(...) and kslide_encoder_set_window(...)
+/// does not have to be called before each encoding.
+///
+/// @param encoder The encoder to configure
+/// @param enabled 1 to enable tracking of the stream, 0 to disable it.
+KODO_SLIDE_API
+void kslide_encoder_set_track_stream(kslide_encoder_t* encoder,
+                                     uint8_t enabled);
+
+/// @param encoder The encoder to query
+/// @return 1 if the window tracks the stream, and otherwise 0.
+KODO_SLIDE_API
+uint8_t kslide_encoder_track_stream(kslide_encoder_t* encoder);
+
 /// @param encoder The encoder to query
 /// @return The size of the coefficient vector in the current window in
 ///         bytes. The number of coefficients is equal to the number of
@@ -310,6 +343,20 @@ void kslide_encoder_write_source_symbol(kslide_encoder_t* encoder,
 // DECODER API
 //------------------------------------------------------------------
 
+/// Resets the decoder for a new stream, as if it was just built with the
+/// same field and symbol size. The stream and the window are emptied and
+/// the stream indices start from zero again. The buffers allocated through
+/// kslide_set_allocator() are kept, so once a recycled decoder has seen a
+/// flow, later flows which are no larger do not allocate through it. The
+/// kodo-slide decoder is initialized again in place, and whether it keeps its
+/// own memory is up to kodo-slide. Settings such as
+/// kslide_decoder_set_track_stream() and the scratch arena are kept. A
+/// decoder with a file sink must not be reset, since the sink refers to its
+/// stream, see kslide_delete_file_sink(...).
+/// @param decoder The decoder to reset
+KODO_SLIDE_API
+void kslide_decoder_reset(kslide_decoder_t* decoder);
+
 /// @param decoder The decoder to query
 /// @return The size of a symbol in the stream in bytes.
 KODO_SLIDE_API
@@ -364,6 +411,38 @@ uint64_t kslide_decoder_push_front_symbol(kslide_decoder_t* decoder,
 KODO_SLIDE_API
 uint64_t kslide_decoder_pop_back_symbol(kslide_decoder_t* decoder);
 
+/// Adds a new symbol with a deadline to the front of the decoder. A symbol
+/// is worthless after its deadline (e.g. its playout time), and it is
+/// popped by the next call to kslide_decoder_expire(...) after the deadline
+/// has passed. Symbols pushed with kslide_decoder_push_front_symbol(...)
+/// never expire.
+///
+/// @param decoder The decoder to use
+/// @param symbol Pointer to the symbol, see
+///        kslide_decoder_push_front_symbol(...)
+/// @param deadline The deadline of the symbol. The unit is defined by the
+///        caller, but must be the same as for kslide_decoder_expire(...).
+/// @return The stream index of the symbol being added.
+KODO_SLIDE_API
+uint64_t kslide_decoder_push_front_symbol_with_deadline(
+    kslide_decoder_t* decoder, uint8_t* symbol, uint64_t deadline);
+
+/// Pop the expired symbols from the back of the stream, i.e. the oldest
+/// symbols with a deadline less than or equal to the current time. The
+/// expiry stops at the first symbol which has not expired, so deadlines
+/// should not decrease with the stream index. Popping a symbol also removes
+/// it from all partially decoded symbols, so no further work is spent on
+/// it. Pending reads (see kslide_decoder_set_read_budget(...)) whose
+/// window only holds expired symbols are dropped without being applied and
+/// counted by kslide_decoder_dropped_reads().
+///
+/// @param decoder The decoder to use
+/// @param now The current time
+/// @return The number of symbols popped. The popped symbols are the ones
+///         below the new stream lower bound.
+KODO_SLIDE_API
+uint64_t kslide_decoder_expire(kslide_decoder_t* decoder, uint64_t now);
+
 /// @param decoder The decoder to query
 /// @return The number of symbols currently in the coding window. The
 ///         window must be within the bounds of the stream.
@@ -397,6 +476,23 @@ KODO_SLIDE_API
 void kslide_decoder_set_window(kslide_decoder_t* decoder,
                                uint64_t lower_bound, uint64_t symbols);
 
+/// Enable or disable tracking of the stream. While enabled the window
+/// automatically covers the entire stream, i.e. it is updated on every
+/// kslide_decoder_push_front_symbol(...) and
+/// kslide_decoder_pop_back_symbol(...). This is useful when the decoder's
+/// stream is kept in sync with the encoder's stream.
+///
+/// @param decoder The decoder to configure
+/// @param enabled 1 to enable tracking of the stream, 0 to disable it.
+KODO_SLIDE_API
+void kslide_decoder_set_track_stream(kslide_decoder_t* decoder,
+                                     uint8_t enabled);
+
+/// @param decoder The decoder to query
+/// @return 1 if the window tracks the stream, and otherwise 0.
+KODO_SLIDE_API
+uint8_t kslide_decoder_track_stream(kslide_decoder_t* decoder);
+
 /// @param decoder The decoder to query
 /// @return The size of the coefficient vector in the current window in
 ///         bytes. The number of coefficients is equal to the number of
@@ -482,6 +578,1304 @@ KODO_SLIDE_API
 uint8_t kslide_decoder_is_symbol_decoded(kslide_decoder_t* decoder,
                                          uint64_t index);
 
+/// The decoded prefix is the contiguous range of decoded symbols starting at
+/// the stream lower bound. These symbols can be delivered in order and
+/// popped from the stream, e.g.:
+///
+///     uint64_t end = kslide_decoder_decoded_prefix_upper_bound(decoder);
+///     while (kslide_decoder_stream_lower_bound(decoder) < end)
+///     {
+///         deliver(...);
+///         kslide_decoder_pop_back_symbol(decoder);
+///     }
+///
+/// The prefix is tracked incrementally, so each symbol is only checked once
+/// after it has been decoded.
+///
+/// @param decoder The decoder to query
+/// @return The index of the first symbol in the stream which is not
+///         decoded, or the stream upper bound if all symbols are decoded.
+KODO_SLIDE_API
+uint64_t kslide_decoder_decoded_prefix_upper_bound(kslide_decoder_t* decoder);
+
+//------------------------------------------------------------------
+// DECODER SNAPSHOT API
+//------------------------------------------------------------------
+
+/// A snapshot is a flat buffer containing the stream bounds, the window and
+/// the decoded symbols of a decoder. It contains no pointers and can
+/// therefore be written to a file or shared memory and restored in another
+/// process, e.g. a hot standby receiver.
+///
+/// Note, only the fully decoded symbols are included in the snapshot. The
+/// partially decoded symbols are considered missing after a restore, and so
+/// are the pending reads of kslide_decoder_set_read_budget(...). Apply them
+/// first, e.g. with kslide_decoder_step(...), to include them.
+///
+/// Restoring takes time in the number of stream symbols of the snapshot,
+/// not in its stream lower bound, so long-lived streams are restored as
+/// quickly as new ones.
+
+/// @param decoder The decoder to query
+/// @return The size of the snapshot of the decoder's current state in bytes.
+KODO_SLIDE_API
+uint64_t kslide_decoder_snapshot_size(kslide_decoder_t* decoder);
+
+/// Write a snapshot of the decoder's current state.
+/// @param decoder The decoder to snapshot
+/// @param snapshot The buffer where the snapshot will be stored. The buffer
+///        must be kslide_decoder_snapshot_size() large. It does not have to
+///        be aligned.
+KODO_SLIDE_API
+void kslide_decoder_snapshot(kslide_decoder_t* decoder, uint8_t* snapshot);
+
+/// @param snapshot The snapshot to query
+/// @return The stream lower bound of the decoder stored in the snapshot.
+KODO_SLIDE_API
+uint64_t kslide_decoder_snapshot_stream_lower_bound(const uint8_t* snapshot);
+
+/// @param snapshot The snapshot to query
+/// @return The number of stream symbols of the decoder stored in the
+///         snapshot. This is the number of symbol buffers which must be
+///         passed to kslide_decoder_restore(...).
+KODO_SLIDE_API
+uint64_t kslide_decoder_snapshot_stream_symbols(const uint8_t* snapshot);
+
+/// Restore the state stored in a snapshot. The decoder must have been built
+/// with the same symbol size as the decoder the snapshot was taken from, and
+/// its stream must be empty.
+///
+/// The snapshot is checked against its size before the decoder is changed,
+/// so a truncated or corrupt snapshot leaves the decoder as it was.
+///
+/// @param decoder The decoder to restore
+/// @param snapshot The snapshot created with kslide_decoder_snapshot(...)
+/// @param size The size of the snapshot buffer in bytes
+/// @param symbols Array of kslide_decoder_snapshot_stream_symbols() symbol
+///        buffers which will be pushed to the decoder's stream. The first
+///        buffer is used for the symbol at the snapshot's stream lower
+///        bound. The same rules apply to the buffers as for
+///        kslide_decoder_push_front_symbol(...).
+/// @return 1 if the snapshot was restored, and otherwise 0 (i.e. if the
+///         snapshot is truncated, invalid or incompatible with the decoder).
+KODO_SLIDE_API
+uint8_t kslide_decoder_restore(kslide_decoder_t* decoder,
+                               const uint8_t* snapshot, uint64_t size,
+                               uint8_t** symbols);
+
+//------------------------------------------------------------------
+// DECODER PIPELINE API
+//------------------------------------------------------------------
+
+/// A decoder pipeline runs a decoder on a dedicated worker thread. The
+/// operations on the decoder are submitted to a lock-free queue by a single
+/// producer thread (e.g. the network thread) and are applied in order by the
+/// worker. The worker reports the decoded and popped symbols on a second
+/// lock-free queue which is polled by a single consumer thread. Submitting
+/// never blocks, so the cost of decoding is kept off the producer thread.
+///
+/// While the pipeline exists the decoder must not be used directly.
+
+/// Opaque pointer used for decoder pipelines
+typedef struct kslide_decoder_pipeline kslide_decoder_pipeline_t;
+
+/// Enum specifying the types of pipeline events
+typedef enum
+{
+    /// The symbol with the event's index is decoded. Its data is final.
+    kslide_pipeline_symbol_decoded,
+
+    /// The symbol with the event's index has been popped from the stream.
+    /// Its storage is no longer used by the decoder.
+    kslide_pipeline_symbol_popped
+}
+kslide_pipeline_event_type;
+
+/// An event reported by the pipeline
+typedef struct
+{
+    /// The event type, see kslide_pipeline_event_type
+    int32_t m_type;
+
+    /// The stream index of the symbol
+    uint64_t m_index;
+}
+kslide_pipeline_event;
+
+/// Build a new decoder pipeline and start its worker thread
+/// @param decoder The decoder which will be used by the worker
+/// @param queue_size The maximum number of queued operations and the
+///        maximum number of unpolled events
+/// @param max_coefficient_vector_size The largest coefficient vector which
+///        can be passed to kslide_decoder_pipeline_read_symbol(...)
+/// @return Pointer to the new pipeline
+KODO_SLIDE_API
+kslide_decoder_pipeline_t* kslide_new_decoder_pipeline(
+    kslide_decoder_t* decoder, uint64_t queue_size,
+    uint64_t max_coefficient_vector_size);
+
+/// Stop the worker thread after all queued operations have been applied and
+/// release the memory consumed by the pipeline. The decoder is not deleted.
+/// @param pipeline The pipeline which should be deallocated
+KODO_SLIDE_API
+void kslide_delete_decoder_pipeline(kslide_decoder_pipeline_t* pipeline);
+
+/// Queue a kslide_decoder_push_front_symbol(...) operation.
+/// @param pipeline The pipeline to use
+/// @param symbol The storage of the symbol, see
+///        kslide_decoder_push_front_symbol(...)
+/// @return 1 if the operation was queued, or 0 if the queue is full.
+KODO_SLIDE_API
+uint8_t kslide_decoder_pipeline_push_front_symbol(
+    kslide_decoder_pipeline_t* pipeline, uint8_t* symbol);
+
+/// Queue a kslide_decoder_pop_back_symbol(...) operation. A
+/// kslide_pipeline_symbol_popped event is reported when it is applied.
+/// @param pipeline The pipeline to use
+/// @return 1 if the operation was queued, or 0 if the queue is full.
+KODO_SLIDE_API
+uint8_t kslide_decoder_pipeline_pop_back_symbol(
+    kslide_decoder_pipeline_t* pipeline);
+
+/// Queue a coded symbol for decoding. The symbol and coefficients are copied
+/// into the queue.
+/// @param pipeline The pipeline to use
+/// @param window_lower_bound The lower bound of the window used to encode
+///        the symbol
+/// @param window_symbols The number of symbols in the window
+/// @param symbol The coded symbol, kslide_decoder_symbol_size() large
+/// @param coefficients The coding coefficients
+/// @param coefficient_vector_size The size of the coefficients in bytes
+/// @return 1 if the symbol was queued, or 0 if the queue is full.
+KODO_SLIDE_API
+uint8_t kslide_decoder_pipeline_read_symbol(
+    kslide_decoder_pipeline_t* pipeline, uint64_t window_lower_bound,
+    uint64_t window_symbols, const uint8_t* symbol,
+    const uint8_t* coefficients, uint64_t coefficient_vector_size);
+
+/// Queue a coded symbol for decoding where the coefficients are generated
+/// from a seed by the worker. The symbol is copied into the queue.
+/// @param pipeline The pipeline to use
+/// @param window_lower_bound The lower bound of the window used to encode
+///        the symbol
+/// @param window_symbols The number of symbols in the window
+/// @param symbol The coded symbol, kslide_decoder_symbol_size() large
+/// @param seed The seed used to generate the coding coefficients
+/// @return 1 if the symbol was queued, or 0 if the queue is full.
+KODO_SLIDE_API
+uint8_t kslide_decoder_pipeline_read_seeded_symbol(
+    kslide_decoder_pipeline_t* pipeline, uint64_t window_lower_bound,
+    uint64_t window_symbols, const uint8_t* symbol, uint64_t seed);
+
+/// Queue a source symbol. The symbol is copied into the queue.
+/// @param pipeline The pipeline to use
+/// @param symbol The source symbol, kslide_decoder_symbol_size() large
+/// @param index The index of the source symbol in the stream
+/// @return 1 if the symbol was queued, or 0 if the queue is full.
+KODO_SLIDE_API
+uint8_t kslide_decoder_pipeline_read_source_symbol(
+    kslide_decoder_pipeline_t* pipeline, const uint8_t* symbol,
+    uint64_t index);
+
+/// Fetch the next event reported by the worker.
+/// @param pipeline The pipeline to poll
+/// @param event Where the event will be stored
+/// @return 1 if an event was fetched, or 0 if there are no pending events.
+KODO_SLIDE_API
+uint8_t kslide_decoder_pipeline_poll(kslide_decoder_pipeline_t* pipeline,
+                                     kslide_pipeline_event* event);
+
+//------------------------------------------------------------------
+// FILE SOURCE API
+//------------------------------------------------------------------
+
+/// A file source pushes the symbols of a file to an encoder directly from a
+/// read-only memory mapping of the file, i.e. without copying the data.
+/// The pages ahead of the stream are read ahead and the pages behind the
+/// stream are released as symbols are popped, so the resident memory is
+/// bounded by the size of the stream rather than the size of the file.
+///
+/// The file is split into kslide_encoder_symbol_size() symbols, the last
+/// symbol is padded with zeros. The first symbol of the file gets the
+/// encoder's stream upper bound at the time the file source is built.
+///
+/// Note, file sources are only supported on platforms with mmap.
+
+/// Opaque pointer used for file sources
+typedef struct kslide_file_source kslide_file_source_t;
+
+/// Build a new file source. An encoder can only have a single file source
+/// at a time.
+/// @param encoder The encoder to which the symbols will be pushed
+/// @param path The path of the file
+/// @return Pointer to the new file source, or NULL if the file could not be
+///         mapped or is empty.
+KODO_SLIDE_API
+kslide_file_source_t* kslide_new_file_source(kslide_encoder_t* encoder,
+                                             const char* path);
+
+/// Unmap the file and release the memory consumed by the file source. The
+/// encoder is not deleted, but must not use symbols of the file afterwards.
+/// @param source The file source which should be deallocated
+KODO_SLIDE_API
+void kslide_delete_file_source(kslide_file_source_t* source);
+
+/// @param source The file source to query
+/// @return The number of symbols in the file.
+KODO_SLIDE_API
+uint64_t kslide_file_source_symbols(kslide_file_source_t* source);
+
+/// @param source The file source to query
+/// @return The size of the file in bytes.
+KODO_SLIDE_API
+uint64_t kslide_file_source_file_size(kslide_file_source_t* source);
+
+/// @param source The file source to configure
+/// @param symbols The number of symbols to read ahead of the stream upper
+///        bound. The default is 64.
+KODO_SLIDE_API
+void kslide_file_source_set_readahead(kslide_file_source_t* source,
+                                      uint64_t symbols);
+
+/// Push the next symbol of the file to the front of the encoder's stream.
+/// The encoder must not be pushed other symbols while the file source is in
+/// use.
+/// @param source The file source to use
+/// @return 1 if a symbol was pushed, or 0 if the end of the file is reached.
+KODO_SLIDE_API
+uint8_t kslide_file_source_push_front_symbol(kslide_file_source_t* source);
+
+/// Pop the oldest symbol from the encoder's stream and release the pages of
+/// the file which are no longer in the stream. The pages are released the
+/// same way for every symbol popped from the encoder while the source
+/// exists, e.g. by kslide_encoder_pop_back_symbol(...) or
+/// kslide_encoder_read_feedback(...).
+/// @param source The file source to use
+/// @return The index of the symbol being removed
+KODO_SLIDE_API
+uint64_t kslide_file_source_pop_back_symbol(kslide_file_source_t* source);
+
+/// @param source The file source to query
+/// @return The number of bytes at the start of the file which have been
+///         released from the resident memory. Only whole pages are
+///         released.
+KODO_SLIDE_API
+uint64_t kslide_file_source_released_size(kslide_file_source_t* source);
+
+//------------------------------------------------------------------
+// FILE SINK API
+//------------------------------------------------------------------
+
+/// A file sink uses a writable memory mapping of an output file as the
+/// storage of a decoder's stream, so the symbols are decoded directly into
+/// the file. As symbols are popped from the stream their pages are flushed
+/// and released from the resident memory.
+///
+/// The file is split into kslide_decoder_symbol_size() symbols. The first
+/// symbol of the file gets the decoder's stream upper bound at the time the
+/// file sink is built. Symbols which are not decoded when they are popped
+/// are left as zeros in the file.
+///
+/// Note, file sinks are only supported on platforms with mmap.
+
+/// Opaque pointer used for file sinks
+typedef struct kslide_file_sink kslide_file_sink_t;
+
+/// Build a new file sink. The file is created, or truncated if it exists.
+/// A decoder can only have a single file sink at a time.
+/// @param decoder The decoder to which the storage will be pushed
+/// @param path The path of the file
+/// @param file_size The size of the file in bytes
+/// @return Pointer to the new file sink, or NULL if the file could not be
+///         created or mapped.
+KODO_SLIDE_API
+kslide_file_sink_t* kslide_new_file_sink(kslide_decoder_t* decoder,
+                                         const char* path, uint64_t file_size);
+
+/// Flush and close the file and release the memory consumed by the file
+/// sink. The decoder is not deleted, but must not use the symbols of the
+/// file afterwards.
+/// @param sink The file sink which should be deallocated
+KODO_SLIDE_API
+void kslide_delete_file_sink(kslide_file_sink_t* sink);
+
+/// @param sink The file sink to query
+/// @return The number of symbols in the file.
+KODO_SLIDE_API
+uint64_t kslide_file_sink_symbols(kslide_file_sink_t* sink);
+
+/// Push the storage of the next symbol of the file to the front of the
+/// decoder's stream. The decoder must not be pushed other symbols while the
+/// file sink is in use.
+/// @param sink The file sink to use
+/// @return 1 if a symbol was pushed, or 0 if the end of the file is reached.
+KODO_SLIDE_API
+uint8_t kslide_file_sink_push_front_symbol(kslide_file_sink_t* sink);
+
+/// Push the storage of the next symbol of the file with a deadline, see
+/// kslide_decoder_push_front_symbol_with_deadline(...). Expired symbols
+/// are released like symbols popped with kslide_file_sink_pop_back_symbol.
+/// @param sink The file sink to use
+/// @param deadline The deadline of the symbol
+/// @return 1 if a symbol was pushed, or 0 if the end of the file is reached.
+KODO_SLIDE_API
+uint8_t kslide_file_sink_push_front_symbol_with_deadline(
+    kslide_file_sink_t* sink, uint64_t deadline);
+
+/// Pop the oldest symbol from the decoder's stream and flush and release
+/// the pages of the file which are no longer in the stream. The same is
+/// done for every symbol popped from the decoder while the sink exists,
+/// e.g. by kslide_decoder_pop_back_symbol(...) or kslide_decoder_expire(...).
+/// @param sink The file sink to use
+/// @return The index of the symbol being removed
+KODO_SLIDE_API
+uint64_t kslide_file_sink_pop_back_symbol(kslide_file_sink_t* sink);
+
+//------------------------------------------------------------------
+// COEFFICIENT COMPRESSION API
+//------------------------------------------------------------------
+
+/// Coefficient vectors can be compressed for transmission when they cannot
+/// be represented by a seed (e.g. for recoded symbols). The compressed size
+/// scales with the number of non-zero coefficients instead of the number of
+/// symbols in the window: zero regions are run-length encoded and sparse
+/// vectors are sent as a bitmap followed by the non-zero values. A vector
+/// never grows by more than a single byte.
+
+/// @param c_field The finite field of the coefficients
+/// @param symbols The number of coefficients, i.e. the window symbols
+/// @return The largest possible size of a compressed coefficient vector in
+///         bytes.
+KODO_SLIDE_API
+uint64_t kslide_coefficients_max_compressed_size(int32_t c_field,
+                                                 uint64_t symbols);
+
+/// Compress a coefficient vector.
+/// @param c_field The finite field of the coefficients
+/// @param symbols The number of coefficients, i.e. the window symbols
+/// @param coefficients The coefficient vector
+/// @param data The buffer where the compressed vector will be stored. It
+///        must be kslide_coefficients_max_compressed_size() large.
+/// @return The size of the compressed vector in bytes.
+KODO_SLIDE_API
+uint64_t kslide_compress_coefficients(int32_t c_field, uint64_t symbols,
+                                      const uint8_t* coefficients,
+                                      uint8_t* data);
+
+/// Decompress a coefficient vector.
+/// @param c_field The finite field of the coefficients
+/// @param symbols The number of coefficients, i.e. the window symbols
+/// @param data The compressed vector
+/// @param size The number of bytes available in data
+/// @param coefficients The buffer where the coefficient vector will be
+///        stored. It must be the size of the coefficient vector.
+/// @return The number of bytes read from data, or 0 if data is not a valid
+///         compressed vector.
+KODO_SLIDE_API
+uint64_t kslide_decompress_coefficients(int32_t c_field, uint64_t symbols,
+                                        const uint8_t* data, uint64_t size,
+                                        uint8_t* coefficients);
+
+/// Compress a coefficient vector for the encoder's current window.
+/// @param encoder The encoder to use
+/// @param coefficients The coefficient vector
+/// @param data The buffer where the compressed vector will be stored. It
+///        must be kslide_coefficients_max_compressed_size() large.
+/// @return The size of the compressed vector in bytes.
+KODO_SLIDE_API
+uint64_t kslide_encoder_compress_coefficients(kslide_encoder_t* encoder,
+                                              const uint8_t* coefficients,
+                                              uint8_t* data);
+
+/// Decodes a coded symbol with a compressed coefficient vector for the
+/// decoder's current window. See kslide_decoder_read_symbol(...).
+/// @param decoder The decoder to use
+/// @param symbol Buffer representing a coded symbol
+/// @param data The compressed coefficient vector
+/// @param size The number of bytes available in data
+/// @return The number of bytes read from data, or 0 if data is not a valid
+///         compressed vector in which case the symbol is not decoded.
+KODO_SLIDE_API
+uint64_t kslide_decoder_read_compressed_symbol(kslide_decoder_t* decoder,
+                                               uint8_t* symbol,
+                                               const uint8_t* data,
+                                               uint64_t size);
+
+//------------------------------------------------------------------
+// SCRATCH API
+//------------------------------------------------------------------
+
+/// A scratch arena holds the transient buffers used by the C API, e.g. the
+/// expanded coefficient vectors of kslide_decoder_read_compressed_symbol().
+/// By default every encoder and decoder has its own arena. When a thread
+/// serves many encoders and decoders, they can share a single arena so the
+/// transient buffers are allocated once and stay in the cache.
+///
+/// An arena is not thread-safe: it must only be shared by encoders and
+/// decoders which are used from the same thread, and it must outlive them.
+
+/// Opaque pointer used for scratch arenas
+typedef struct kslide_scratch kslide_scratch_t;
+
+/// Creates a new scratch arena
+/// @return A new scratch arena
+KODO_SLIDE_API
+kslide_scratch_t* kslide_new_scratch();
+
+/// Deallocates and releases the memory consumed by a scratch arena
+/// @param scratch The scratch arena which should be deallocated
+KODO_SLIDE_API
+void kslide_delete_scratch(kslide_scratch_t* scratch);
+
+/// @param scratch The scratch arena to query
+/// @return The number of bytes currently held by the scratch arena
+KODO_SLIDE_API
+uint64_t kslide_scratch_size(kslide_scratch_t* scratch);
+
+/// Sets the scratch arena used by an encoder.
+/// @param encoder The encoder to use
+/// @param scratch The scratch arena, or NULL to use the encoder's own arena
+KODO_SLIDE_API
+void kslide_encoder_set_scratch(kslide_encoder_t* encoder,
+                                kslide_scratch_t* scratch);
+
+/// Sets the scratch arena used by a decoder.
+/// @param decoder The decoder to use
+/// @param scratch The scratch arena, or NULL to use the decoder's own arena
+KODO_SLIDE_API
+void kslide_decoder_set_scratch(kslide_decoder_t* decoder,
+                                kslide_scratch_t* scratch);
+
+//------------------------------------------------------------------
+// ALLOCATOR API
+//------------------------------------------------------------------
+
+/// The memory allocation functions used by the C API. Each function is
+/// passed the context of the allocator.
+typedef struct
+{
+    /// Allocates size bytes suitably aligned for any type. Returns NULL if
+    /// the allocation fails.
+    void* (*m_malloc)(void* context, uint64_t size);
+
+    /// Allocates size bytes aligned to alignment, which is a power of two.
+    /// Returns NULL if the allocation fails.
+    void* (*m_aligned_alloc)(void* context, uint64_t alignment,
+                             uint64_t size);
+
+    /// Releases memory returned by m_malloc or m_aligned_alloc
+    void (*m_free)(void* context, void* ptr);
+
+    /// User provided context, e.g. a NUMA node or huge page pool
+    void* m_context;
+}
+kslide_allocator;
+
+/// Sets the allocator used for the factories, encoders, decoders and the
+/// other objects of the C API and for their buffers. The allocations done
+/// inside the wrapped kodo-slide coders are not affected.
+///
+/// The allocator must be set before any object is created, and it must not
+/// be changed while objects exist, since the objects are released with the
+/// allocator which is set at that time. It is not thread-safe.
+///
+/// @param allocator The allocator to use. It is copied. Pass NULL to use the
+///        default allocator which is based on malloc and free.
+KODO_SLIDE_API
+void kslide_set_allocator(const kslide_allocator* allocator);
+
+//------------------------------------------------------------------
+// ENCODER BATCH API
+//------------------------------------------------------------------
+
+/// The batch functions produce one coded symbol for each of a number of
+/// encoders with the same coefficient vector, e.g. for many flows which
+/// are coded in lockstep. The encoders must use the same finite field and
+/// symbol size and have the same number of symbols in their windows.
+///
+/// Each coded symbol is still computed by its own encoder, so the coding
+/// work is the same as calling kslide_encoder_write_symbol(...) for each
+/// encoder. Only kslide_encoders_write_seeded_symbols(...) saves work,
+/// since it generates the coefficient vector once for the batch.
+
+/// Write a coded symbol with the same coefficients for each encoder. This
+/// is a convenience wrapper which calls kslide_encoder_write_symbol(...)
+/// for each encoder.
+/// @param encoders The encoders to use
+/// @param count The number of encoders
+/// @param symbols The buffers where the coded symbols will be stored, one
+///        for each encoder
+/// @param coefficients The coding coefficients, see
+///        kslide_encoder_write_symbol(...)
+KODO_SLIDE_API
+void kslide_encoders_write_symbols(kslide_encoder_t** encoders,
+                                   uint64_t count, uint8_t** symbols,
+                                   const uint8_t* coefficients);
+
+/// Write a coded symbol with the coefficients generated from a seed for
+/// each encoder. The coefficients are generated once by the first encoder,
+/// and they are the same as generated by kslide_encoder_set_seed(...) and
+/// kslide_encoder_generate(...) on each of the encoders. The encoders must
+/// use the same coefficient generator. The counter based generator also
+/// depends on the position of the window, so with it the windows of the
+/// encoders must start at the same stream index.
+/// @param encoders The encoders to use
+/// @param count The number of encoders
+/// @param symbols The buffers where the coded symbols will be stored, one
+///        for each encoder
+/// @param seed The seed of the coefficients
+KODO_SLIDE_API
+void kslide_encoders_write_seeded_symbols(kslide_encoder_t** encoders,
+                                          uint64_t count, uint8_t** symbols,
+                                          uint64_t seed);
+
+//------------------------------------------------------------------
+// ENCODER ACCUMULATOR API
+//------------------------------------------------------------------
+
+/// An encoder can maintain a number of running repair symbols which cover
+/// the entire stream. Each symbol pushed to the stream is added to the
+/// repair symbols with random coefficients, and it is removed again when
+/// it is popped. The cost of coding is thereby spread over the pushes and
+/// pops, and writing a repair symbol is a copy of the symbol and its
+/// coefficients.
+
+/// Enables the running repair symbols. The symbols already in the stream
+/// are added right away. Initializing the encoder with a factory disables
+/// them again.
+/// @param encoder The encoder to use
+/// @param accumulators The number of running repair symbols, or 0 to
+///        disable them
+/// @param seed The seed of the generator of the coefficients
+KODO_SLIDE_API
+void kslide_encoder_set_accumulators(kslide_encoder_t* encoder,
+                                     uint64_t accumulators, uint64_t seed);
+
+/// @param encoder The encoder to query
+/// @return The number of running repair symbols
+KODO_SLIDE_API
+uint64_t kslide_encoder_accumulators(kslide_encoder_t* encoder);
+
+/// Write a running repair symbol and its coefficients. The window of the
+/// encoder must cover the entire stream, see
+/// kslide_encoder_set_track_stream(...), and the symbol is decoded with the
+/// same window at the decoder.
+/// @param encoder The encoder to use
+/// @param accumulator The index of the running repair symbol
+/// @param symbol The buffer where the repair symbol will be stored. It must
+///        be kslide_encoder_symbol_size() large.
+/// @param coefficients The buffer where the coefficients will be stored. It
+///        must be kslide_encoder_coefficient_vector_size() large.
+KODO_SLIDE_API
+void kslide_encoder_write_accumulated_symbol(kslide_encoder_t* encoder,
+                                             uint64_t accumulator,
+                                             uint8_t* symbol,
+                                             uint8_t* coefficients);
+
+//------------------------------------------------------------------
+// CAUCHY COEFFICIENT API
+//------------------------------------------------------------------
+
+/// Structured coefficients as an alternative to the random coefficients of
+/// kslide_encoder_generate(...). Repair symbol r of a window uses row r of a
+/// Cauchy matrix, so any k distinct repair symbols of the same window can
+/// recover any k lost symbols of the window, i.e. the code is MDS within a
+/// window. The repair index is sent instead of a seed, and the decoder
+/// generates the same coefficients for the same window.
+///
+/// The binary field is not supported. The number of repair symbols plus
+/// the number of window symbols is bounded by the size of the field, see
+/// kslide_cauchy_max_symbols(...).
+
+/// @param c_field The finite field to use
+/// @param repairs The number of repair symbols used for each window
+/// @return The largest number of window symbols supported with the given
+///         number of repair symbols, or 0 if the field is not supported.
+KODO_SLIDE_API
+uint64_t kslide_cauchy_max_symbols(int32_t c_field, uint64_t repairs);
+
+/// Generate the Cauchy coefficients of a repair symbol for the current
+/// window of the encoder.
+/// @param encoder The encoder to use
+/// @param repair The index of the repair symbol in the window. The window
+///        symbols must be at most kslide_cauchy_max_symbols(field, repair + 1).
+/// @param coefficients Buffer where the coefficients will be stored. It
+///        must be kslide_encoder_coefficient_vector_size() large.
+KODO_SLIDE_API
+void kslide_encoder_generate_cauchy(kslide_encoder_t* encoder,
+                                    uint64_t repair, uint8_t* coefficients);
+
+/// Generate the Cauchy coefficients of a repair symbol for the current
+/// window of the decoder.
+/// @param decoder The decoder to use
+/// @param repair The index of the repair symbol in the window. The window
+///        symbols must be at most kslide_cauchy_max_symbols(field, repair + 1).
+/// @param coefficients Buffer where the coefficients will be stored. It
+///        must be kslide_decoder_coefficient_vector_size() large.
+KODO_SLIDE_API
+void kslide_decoder_generate_cauchy(kslide_decoder_t* decoder,
+                                    uint64_t repair, uint8_t* coefficients);
+
+//------------------------------------------------------------------
+// FEEDBACK API
+//------------------------------------------------------------------
+
+/// Feedback tells the encoder which symbols the decoder has. The decoder
+/// writes its decoded prefix, the number of missing symbols and a bitmap of
+/// the decoded symbols after the prefix in a compact format. The bitmap is
+/// compressed like a binary coefficient vector, see
+/// kslide_compress_coefficients(...), so a long stream with few losses gives
+/// small feedback. The encoder pops the symbols of the prefix since they are
+/// no longer needed, so the window is narrowed to the symbols which the
+/// decoder still lacks.
+
+/// @param decoder The decoder to query
+/// @return The largest possible size of the feedback of the decoder in
+///         bytes.
+KODO_SLIDE_API
+uint64_t kslide_decoder_feedback_max_size(kslide_decoder_t* decoder);
+
+/// Write the feedback of the decoder.
+/// @param decoder The decoder to use
+/// @param data The buffer where the feedback will be stored. It must be
+///        kslide_decoder_feedback_max_size() large.
+/// @return The size of the feedback in bytes
+KODO_SLIDE_API
+uint64_t kslide_decoder_write_feedback(kslide_decoder_t* decoder,
+                                       uint8_t* data);
+
+/// Read feedback from a decoder and pop the symbols which the decoder has
+/// decoded in order, see kslide_decoder_decoded_prefix_upper_bound(...).
+/// The window is moved past the popped symbols.
+/// @param encoder The encoder to use
+/// @param data The feedback
+/// @param size The number of bytes available in data
+/// @return The number of bytes read from data, or 0 if the data is not valid
+///         feedback for the stream of the encoder.
+KODO_SLIDE_API
+uint64_t kslide_encoder_read_feedback(kslide_encoder_t* encoder,
+                                      const uint8_t* data, uint64_t size);
+
+/// @param encoder The encoder to query
+/// @return The number of symbols missing at the decoder according to the
+///         last feedback, i.e. the number of coded symbols it still needs.
+KODO_SLIDE_API
+uint64_t kslide_encoder_feedback_symbols_missing(kslide_encoder_t* encoder);
+
+/// @param encoder The encoder to query
+/// @param index Index of the symbol to check
+/// @return 1 if the symbol was decoded according to the last feedback,
+///         otherwise 0.
+KODO_SLIDE_API
+uint8_t kslide_encoder_feedback_is_symbol_decoded(kslide_encoder_t* encoder,
+                                                  uint64_t index);
+
+//------------------------------------------------------------------
+// TRACE API
+//------------------------------------------------------------------
+
+/// An encoder or decoder can record its most recent coding events in a
+/// ring buffer for offline analysis, e.g. to find out why a symbol took
+/// long to decode. The trace is disabled by default. The events can be
+/// copied out or dumped to a trace file which is read by the
+/// kodo_slide_c_trace_reader program.
+///
+/// A trace file is a kslide_trace_header followed by the events, oldest
+/// first. All fields are stored in the native byte order.
+
+/// Enum specifying the types of trace events
+typedef enum
+{
+    /// A symbol was pushed. m_index is its index and m_symbols the number
+    /// of stream symbols.
+    kslide_trace_push_front_symbol,
+
+    /// A symbol was popped. m_index is its index and m_symbols the number
+    /// of stream symbols.
+    kslide_trace_pop_back_symbol,
+
+    /// The window was set. m_index is the window lower bound and m_symbols
+    /// the window symbols.
+    kslide_trace_set_window,
+
+    /// A coded symbol was read (decoder) or written (encoder). m_index is
+    /// the window lower bound and m_symbols the window symbols.
+    kslide_trace_coded_symbol,
+
+    /// A source symbol was read (decoder) or written (encoder). m_index is
+    /// its index.
+    kslide_trace_source_symbol
+}
+kslide_trace_event_type;
+
+/// A trace event
+typedef struct
+{
+    /// The time of the event in nanoseconds of a monotonic clock
+    uint64_t m_time;
+
+    /// The stream index of the event, see kslide_trace_event_type
+    uint64_t m_index;
+
+    /// The number of symbols of the event, see kslide_trace_event_type
+    uint64_t m_symbols;
+
+    /// The rank of the decoder after the event (0 for encoders)
+    uint64_t m_rank;
+
+    /// The decoded prefix upper bound of the decoder after reading a symbol,
+    /// see kslide_decoder_decoded_prefix_upper_bound(...) (0 otherwise)
+    uint64_t m_value;
+
+    /// The event type, see kslide_trace_event_type
+    int32_t m_type;
+
+    /// 1 if a symbol read by the decoder increased its rank, otherwise 0
+    uint32_t m_innovative;
+}
+kslide_trace_event;
+
+/// The constants of the trace file header
+enum
+{
+    kslide_trace_magic = 0x4b535452,
+    kslide_trace_version = 1
+};
+
+/// The header of a trace file
+typedef struct
+{
+    /// Identifies a trace file, see kslide_trace_magic
+    uint32_t m_magic;
+
+    /// The version of the format, see kslide_trace_version
+    uint32_t m_version;
+
+    /// The number of events which follow the header
+    uint64_t m_events;
+}
+kslide_trace_header;
+
+/// Enables or disables the trace of an encoder. Any recorded events are
+/// discarded.
+/// @param encoder The encoder to use
+/// @param events The number of most recent events to keep, or 0 to disable
+///        the trace
+KODO_SLIDE_API
+void kslide_encoder_set_trace(kslide_encoder_t* encoder, uint64_t events);
+
+/// @param encoder The encoder to query
+/// @return The number of events in the trace
+KODO_SLIDE_API
+uint64_t kslide_encoder_trace_events(kslide_encoder_t* encoder);
+
+/// Copy the events of the trace, oldest first.
+/// @param encoder The encoder to use
+/// @param events The buffer where the events will be stored. It must hold
+///        kslide_encoder_trace_events() events.
+KODO_SLIDE_API
+void kslide_encoder_copy_trace(kslide_encoder_t* encoder,
+                               kslide_trace_event* events);
+
+/// Write the trace to a trace file.
+/// @param encoder The encoder to use
+/// @param path The path of the file
+/// @return 1 if the file was written, otherwise 0.
+KODO_SLIDE_API
+uint8_t kslide_encoder_dump_trace(kslide_encoder_t* encoder, const char* path);
+
+/// Enables or disables the trace of a decoder. Any recorded events are
+/// discarded.
+/// @param decoder The decoder to use
+/// @param events The number of most recent events to keep, or 0 to disable
+///        the trace
+KODO_SLIDE_API
+void kslide_decoder_set_trace(kslide_decoder_t* decoder, uint64_t events);
+
+/// @param decoder The decoder to query
+/// @return The number of events in the trace
+KODO_SLIDE_API
+uint64_t kslide_decoder_trace_events(kslide_decoder_t* decoder);
+
+/// Copy the events of the trace, oldest first.
+/// @param decoder The decoder to use
+/// @param events The buffer where the events will be stored. It must hold
+///        kslide_decoder_trace_events() events.
+KODO_SLIDE_API
+void kslide_decoder_copy_trace(kslide_decoder_t* decoder,
+                               kslide_trace_event* events);
+
+/// Write the trace to a trace file.
+/// @param decoder The decoder to use
+/// @param path The path of the file
+/// @return 1 if the file was written, otherwise 0.
+KODO_SLIDE_API
+uint8_t kslide_decoder_dump_trace(kslide_decoder_t* decoder, const char* path);
+
+//------------------------------------------------------------------
+// DECODER READ BUDGET API
+//------------------------------------------------------------------
+
+/// A read budget bounds the decoding work done by each call to
+/// kslide_decoder_read_symbol(...). The coded symbols read are copied to a
+/// queue and applied in order, each in the window it was read in, as long
+/// as their work fits in the budget. The remaining reads are applied by
+/// later reads or by kslide_decoder_step(...), e.g. when the network thread
+/// is idle. The work of a coded symbol is the number of symbols in its
+/// window. Source symbols only cost 1 and are always applied right away by
+/// kslide_decoder_read_source_symbol(...), so they never wait behind the
+/// coded symbols.
+///
+/// The queries of the decoder such as kslide_decoder_rank(...) only reflect
+/// the applied reads. Popping a symbol first applies the pending reads
+/// which involve it, together with the reads before them.
+///
+/// The queue holds at most kslide_decoder_max_pending_reads() reads. When
+/// it is full the oldest read is applied to make room, or, if that read
+/// does not fit in the work quota (see kslide_decoder_set_work_quota(...)),
+/// the new read is dropped and counted by kslide_decoder_dropped_reads().
+
+/// Sets the read budget of a decoder.
+/// @param decoder The decoder to use
+/// @param budget The work allowed per read, or 0 to apply all reads right
+///        away in which case any pending reads are applied.
+KODO_SLIDE_API
+void kslide_decoder_set_read_budget(kslide_decoder_t* decoder,
+                                    uint64_t budget);
+
+/// @param decoder The decoder to query
+/// @return The read budget of the decoder
+KODO_SLIDE_API
+uint64_t kslide_decoder_read_budget(kslide_decoder_t* decoder);
+
+/// Applies pending reads as long as their work fits in the budget. The
+/// oldest pending read is always applied, even if it exceeds the budget,
+/// unless it does not fit in the work quota.
+/// @param decoder The decoder to use
+/// @param budget The work allowed
+/// @return The number of reads still pending
+KODO_SLIDE_API
+uint64_t kslide_decoder_step(kslide_decoder_t* decoder, uint64_t budget);
+
+/// @param decoder The decoder to query
+/// @return The number of reads which have not been applied yet
+KODO_SLIDE_API
+uint64_t kslide_decoder_pending_reads(kslide_decoder_t* decoder);
+
+/// Sets the largest number of pending reads. The default is 1024.
+/// @param decoder The decoder to configure
+/// @param max_reads The largest number of pending reads, at least 1
+KODO_SLIDE_API
+void kslide_decoder_set_max_pending_reads(kslide_decoder_t* decoder,
+                                          uint64_t max_reads);
+
+/// @param decoder The decoder to query
+/// @return The largest number of pending reads
+KODO_SLIDE_API
+uint64_t kslide_decoder_max_pending_reads(kslide_decoder_t* decoder);
+
+/// @param decoder The decoder to query
+/// @return The number of reads dropped without being applied since the
+///         decoder was built or reset, because the queue was full or their
+///         symbols were popped, in both cases when the work quota did not
+///         allow them to be applied, or because their work exceeds the
+///         whole work quota.
+KODO_SLIDE_API
+uint64_t kslide_decoder_dropped_reads(kslide_decoder_t* decoder);
+
+//------------------------------------------------------------------
+// WORK ACCOUNTING API
+//------------------------------------------------------------------
+
+/// The coding work of each encoder and decoder is accounted, so the work
+/// spent on a flow can be measured and bounded. The work is counted in
+/// symbol operations, i.e. multiplying a symbol by a coefficient and adding
+/// it to another symbol, which costs kslide_*_symbol_size() bytes of field
+/// arithmetic. A coded symbol counts the number of symbols in its window, a
+/// source symbol counts 1 and so does each running repair symbol updated on
+/// push and pop. The count is an upper bound of the field operations, as
+/// zero coefficients and the elimination within the decoder are not
+/// measured separately.
+///
+/// A work quota bounds the work of a decoder between calls to
+/// kslide_decoder_reset_work(...), e.g. once per scheduling period. While a
+/// quota or a read budget is set, the coded reads go through the queue of
+/// kslide_decoder_set_read_budget(...) and are applied in the order they
+/// arrived. A coded read is only applied while its work fits in what is
+/// left of the quota, also by kslide_decoder_step(...) and when a symbol is
+/// popped; the rest wait for the next period. Reads which cannot wait,
+/// because the queue is full or their symbol is popped, are dropped, and so
+/// are reads whose window exceeds the whole quota, since they would never
+/// fit. See kslide_decoder_dropped_reads(). Source reads are essential and
+/// are applied right away, and their work is counted even beyond the quota.
+///
+/// The quota of an encoder is advisory: the encoder always writes the
+/// symbols asked for, and the application decides what to skip, e.g.
+/// repair symbols, with kslide_encoder_work_left().
+
+/// @param encoder The encoder to query
+/// @return The work done since the encoder was built, reset or since the
+///         last kslide_encoder_reset_work(...)
+KODO_SLIDE_API
+uint64_t kslide_encoder_work(kslide_encoder_t* encoder);
+
+/// Sets the work of an encoder to 0, e.g. at the start of a new period
+/// @param encoder The encoder to use
+KODO_SLIDE_API
+void kslide_encoder_reset_work(kslide_encoder_t* encoder);
+
+/// Sets the work quota of an encoder
+/// @param encoder The encoder to configure
+/// @param quota The work allowed until the next reset, or 0 for no quota
+KODO_SLIDE_API
+void kslide_encoder_set_work_quota(kslide_encoder_t* encoder, uint64_t quota);
+
+/// @param encoder The encoder to query
+/// @return The work quota of the encoder, or 0 if there is no quota
+KODO_SLIDE_API
+uint64_t kslide_encoder_work_quota(kslide_encoder_t* encoder);
+
+/// @param encoder The encoder to query
+/// @return The work left of the quota, or UINT64_MAX if there is no quota
+KODO_SLIDE_API
+uint64_t kslide_encoder_work_left(kslide_encoder_t* encoder);
+
+/// @param decoder The decoder to query
+/// @return The work done since the decoder was built, reset or since the
+///         last kslide_decoder_reset_work(...)
+KODO_SLIDE_API
+uint64_t kslide_decoder_work(kslide_decoder_t* decoder);
+
+/// Sets the work of a decoder to 0, e.g. at the start of a new period.
+/// Deferred reads are applied as long as they fit in the quota.
+/// @param decoder The decoder to use
+KODO_SLIDE_API
+void kslide_decoder_reset_work(kslide_decoder_t* decoder);
+
+/// Sets the work quota of a decoder. Deferred reads are applied as long as
+/// they fit in the new quota.
+/// @param decoder The decoder to configure
+/// @param quota The work allowed until the next reset, or 0 for no quota
+KODO_SLIDE_API
+void kslide_decoder_set_work_quota(kslide_decoder_t* decoder, uint64_t quota);
+
+/// @param decoder The decoder to query
+/// @return The work quota of the decoder, or 0 if there is no quota
+KODO_SLIDE_API
+uint64_t kslide_decoder_work_quota(kslide_decoder_t* decoder);
+
+/// @param decoder The decoder to query
+/// @return The work left of the quota, or UINT64_MAX if there is no quota
+KODO_SLIDE_API
+uint64_t kslide_decoder_work_left(kslide_decoder_t* decoder);
+
+//------------------------------------------------------------------
+// ALIGNMENT API
+//------------------------------------------------------------------
+
+/// The finite field kernels of kodo-slide may be faster when the symbol
+/// buffers are aligned. With the aligned copy enabled, and as long as all
+/// the symbols in the stream of an encoder or decoder have the preferred
+/// alignment, symbols written to or read from unaligned buffers are passed
+/// through an aligned buffer of the encoder or decoder, so the kernels only
+/// see aligned buffers.
+///
+/// The copy costs a memcpy of the symbol for every unaligned write or read,
+/// which is the common case for payloads behind a packet header, so it is
+/// disabled by default. Only enable it when measurements show that the
+/// kernels gain more on aligned buffers than the copy costs.
+
+/// @return The preferred alignment of symbol buffers in bytes
+KODO_SLIDE_API
+uint64_t kslide_preferred_alignment();
+
+/// @param encoder The encoder to query
+/// @return 1 if all symbols in the stream have the preferred alignment,
+///         otherwise 0.
+KODO_SLIDE_API
+uint8_t kslide_encoder_is_aligned(kslide_encoder_t* encoder);
+
+/// @param decoder The decoder to query
+/// @return 1 if all symbols in the stream have the preferred alignment,
+///         otherwise 0.
+KODO_SLIDE_API
+uint8_t kslide_decoder_is_aligned(kslide_decoder_t* decoder);
+
+/// Enable or disable the aligned copy of an encoder. It is disabled by
+/// default.
+/// @param encoder The encoder to configure
+/// @param enabled 1 to enable the aligned copy, 0 to disable it.
+KODO_SLIDE_API
+void kslide_encoder_set_aligned_copy(kslide_encoder_t* encoder,
+                                     uint8_t enabled);
+
+/// @param encoder The encoder to query
+/// @return 1 if the aligned copy is enabled, and otherwise 0.
+KODO_SLIDE_API
+uint8_t kslide_encoder_aligned_copy(kslide_encoder_t* encoder);
+
+/// Enable or disable the aligned copy of a decoder. It is disabled by
+/// default.
+/// @param decoder The decoder to configure
+/// @param enabled 1 to enable the aligned copy, 0 to disable it.
+KODO_SLIDE_API
+void kslide_decoder_set_aligned_copy(kslide_decoder_t* decoder,
+                                     uint8_t enabled);
+
+/// @param decoder The decoder to query
+/// @return 1 if the aligned copy is enabled, and otherwise 0.
+KODO_SLIDE_API
+uint8_t kslide_decoder_aligned_copy(kslide_decoder_t* decoder);
+
+//------------------------------------------------------------------
+// PULL ENCODER API
+//------------------------------------------------------------------
+
+/// A pull encoder drives an encoder whose symbols are not resident in
+/// memory. The stream is defined by indices only, and the data of a symbol
+/// is fetched through a callback when a symbol is written, e.g. from a page
+/// cache or a compressed store. Only the window symbols with a non-zero
+/// coefficient are fetched, one at a time, so the memory used does not
+/// depend on the size of the window.
+///
+/// The window, the seed and the coefficients are handled by the encoder as
+/// usual, e.g. with kslide_encoder_set_window(...) and
+/// kslide_encoder_generate(...). The symbols must be pushed, popped and
+/// written through the pull encoder while it exists, and the running repair
+/// symbols of kslide_encoder_set_accumulators(...) are not supported.
+
+/// Opaque pointer used for pull encoders
+typedef struct kslide_pull_encoder kslide_pull_encoder_t;
+
+/// Callback which fetches the data of a symbol.
+/// @param context The context given to kslide_new_pull_encoder(...)
+/// @param index The stream index of the symbol
+/// @param symbol The buffer where the symbol must be stored. It is
+///        kslide_encoder_symbol_size() large.
+/// @return 1 if the symbol was fetched, otherwise 0.
+typedef uint8_t (*kslide_fetch_symbol_t)(void* context, uint64_t index,
+                                         uint8_t* symbol);
+
+/// Build a new pull encoder
+/// @param encoder The encoder to use. Its stream must be empty.
+/// @param fetch The callback which fetches the data of a symbol
+/// @param context User provided context passed to the callback
+/// @return A new pull encoder
+KODO_SLIDE_API
+kslide_pull_encoder_t* kslide_new_pull_encoder(kslide_encoder_t* encoder,
+                                               kslide_fetch_symbol_t fetch,
+                                               void* context);
+
+/// Deallocates and releases the memory consumed by a pull encoder
+/// @param pull The pull encoder which should be deallocated
+KODO_SLIDE_API
+void kslide_delete_pull_encoder(kslide_pull_encoder_t* pull);
+
+/// Adds a new symbol to the front of the stream. The data of the symbol is
+/// not needed until it is written.
+/// @param pull The pull encoder to use
+/// @return The stream index of the symbol being added.
+KODO_SLIDE_API
+uint64_t kslide_pull_encoder_push_front_symbol(kslide_pull_encoder_t* pull);
+
+/// Remove the "oldest" symbol from the stream.
+/// @param pull The pull encoder to use
+/// @return The index of the symbol being removed
+KODO_SLIDE_API
+uint64_t kslide_pull_encoder_pop_back_symbol(kslide_pull_encoder_t* pull);
+
+/// Write a coded symbol according to the coding coefficients, see
+/// kslide_encoder_write_symbol(...).
+/// @param pull The pull encoder to use
+/// @param symbol The buffer where the coded symbol will be stored. It must be
+///        kslide_encoder_symbol_size() large.
+/// @param coefficients The coding coefficients
+/// @return 1 if the symbol was written, or 0 if a symbol could not be
+///         fetched in which case the content of symbol is undefined.
+KODO_SLIDE_API
+uint8_t kslide_pull_encoder_write_symbol(kslide_pull_encoder_t* pull,
+                                         uint8_t* symbol,
+                                         const uint8_t* coefficients);
+
+/// Write a source symbol to the symbol buffer.
+/// @param pull The pull encoder to use
+/// @param symbol The buffer where the source symbol will be stored. It must
+///        be kslide_encoder_symbol_size() large.
+/// @param index Index of the source symbol in the stream
+/// @return 1 if the symbol was fetched, otherwise 0.
+KODO_SLIDE_API
+uint8_t kslide_pull_encoder_write_source_symbol(kslide_pull_encoder_t* pull,
+                                                uint8_t* symbol,
+                                                uint64_t index);
+
+//------------------------------------------------------------------
+// BLOCK API
+//------------------------------------------------------------------
+
+/// Block mode gives fixed block FEC semantics on top of the encoder and
+/// decoder: the stream is partitioned into non-overlapping blocks of
+/// block_symbols symbols, where block b covers the stream indices
+/// [b * block_symbols, (b + 1) * block_symbols). The source symbols are sent
+/// as they are, and the repair symbols of a block use Cauchy coefficients
+/// where the column of a symbol is its offset in the block. The repair
+/// symbols of a block are therefore rows of the same Cauchy matrix, also
+/// when some of them were written after part of the block was popped, and
+/// any k repair symbols of a block recover any k lost source symbols of
+/// that block.
+///
+/// Block mode is set per encoder and decoder, so block and sliding window
+/// coding can be used side by side with the same factories. It cannot be
+/// combined with kslide_encoder_set_track_stream(...) and requires a field
+/// with Cauchy coefficients, i.e. not kslide_binary.
+
+/// Enable or disable block mode. While enabled the window automatically
+/// covers the symbols of the block of the newest stream symbol which are
+/// still in the stream, i.e. it is updated on every
+/// kslide_encoder_push_front_symbol(...) and
+/// kslide_encoder_pop_back_symbol(...).
+/// @param encoder The encoder to configure
+/// @param block_symbols The number of symbols in a block, or 0 to disable
+///        block mode. It must be at most kslide_cauchy_max_symbols(field, 1).
+KODO_SLIDE_API
+void kslide_encoder_set_block_symbols(kslide_encoder_t* encoder,
+                                      uint64_t block_symbols);
+
+/// @param encoder The encoder to query
+/// @return The number of symbols in a block, or 0 if block mode is disabled.
+KODO_SLIDE_API
+uint64_t kslide_encoder_block_symbols(kslide_encoder_t* encoder);
+
+/// @param encoder The encoder to query. Block mode must be enabled.
+/// @return The index of the current block, i.e. the block covered by the
+///         window.
+KODO_SLIDE_API
+uint64_t kslide_encoder_block(kslide_encoder_t* encoder);
+
+/// Write a repair symbol of the current block. The window lower bound, the
+/// number of symbols in the window and the repair index must be sent along
+/// with the symbol, see kslide_decoder_read_block_symbol(...). The window
+/// lower bound is not always the start of the block, since symbols of the
+/// block may have been popped already.
+/// @param encoder The encoder to use. Block mode must be enabled.
+/// @param symbol The buffer where the repair symbol will be stored. It must
+///        be kslide_encoder_symbol_size() large.
+/// @param coefficients The buffer where the coefficients will be stored. It
+///        must be kslide_encoder_coefficient_vector_size() large.
+/// @param repair The index of the repair symbol within the block. The
+///        offset of the window in the block plus the window symbols must
+///        be at most kslide_cauchy_max_symbols(field, repair + 1).
+KODO_SLIDE_API
+void kslide_encoder_write_block_symbol(kslide_encoder_t* encoder,
+                                       uint8_t* symbol, uint8_t* coefficients,
+                                       uint64_t repair);
+
+/// Enable or disable block mode on a decoder.
+/// @param decoder The decoder to configure
+/// @param block_symbols The number of symbols in a block, or 0 to disable
+///        block mode. It must match the encoder.
+KODO_SLIDE_API
+void kslide_decoder_set_block_symbols(kslide_decoder_t* decoder,
+                                      uint64_t block_symbols);
+
+/// @param decoder The decoder to query
+/// @return The number of symbols in a block, or 0 if block mode is disabled.
+KODO_SLIDE_API
+uint64_t kslide_decoder_block_symbols(kslide_decoder_t* decoder);
+
+/// Read a repair symbol of a block. The window is set to the window of the
+/// encoder, which must be within a single block, and its symbols must be in
+/// the stream. Source symbols are read with
+/// kslide_decoder_read_source_symbol(...).
+/// @param decoder The decoder to use. Block mode must be enabled.
+/// @param symbol The buffer containing the repair symbol
+/// @param coefficients The buffer where the coefficients will be stored. It
+///        must be large enough for the coefficients of the symbols.
+/// @param lower_bound The window lower bound of the encoder
+/// @param symbols The number of symbols in the window of the encoder
+/// @param repair The index of the repair symbol within the block. The
+///        offset of the window in the block plus the symbols must be at
+///        most kslide_cauchy_max_symbols(field, repair + 1).
+KODO_SLIDE_API
+void kslide_decoder_read_block_symbol(kslide_decoder_t* decoder,
+                                      uint8_t* symbol, uint8_t* coefficients,
+                                      uint64_t lower_bound, uint64_t symbols,
+                                      uint64_t repair);
+
+//------------------------------------------------------------------
+// COEFFICIENT GENERATOR API
+//------------------------------------------------------------------
+
+/// The coefficient generator used by kslide_encoder_generate(...) and
+/// kslide_decoder_generate(...) is selected on the factory. The default
+/// generator expands the seed sequentially over the window. The counter
+/// based generator computes each coefficient from the seed and the stream
+/// index of its symbol with the Philox4x32-10 block function, so there is
+/// no sequential state: the coefficients of any slice of a window can be
+/// computed on their own, see kslide_generate_counter_coefficients(...),
+/// and the blocks of a wide window can be computed in parallel.
+///
+/// The generators produce different coefficients, so the encoder and the
+/// decoder must use the same generator.
+
+/// Enum specifying the available coefficient generators
+/// Note: the size of the enum type cannot be guaranteed, so the int32_t type
+/// is used in the API calls to pass the enum values
+typedef enum
+{
+    kslide_generator_default,
+    kslide_generator_counter
+}
+kslide_coefficient_generator;
+
+/// @param factory The factory to configure
+/// @param generator The coefficient generator of the encoders built, see
+///        kslide_coefficient_generator
+KODO_SLIDE_API
+void kslide_encoder_factory_set_generator(kslide_encoder_factory_t* factory,
+                                          int32_t generator);
+
+/// @param factory The factory to query
+/// @return The coefficient generator of the encoders built
+KODO_SLIDE_API
+int32_t kslide_encoder_factory_generator(kslide_encoder_factory_t* factory);
+
+/// @param factory The factory to configure
+/// @param generator The coefficient generator of the decoders built, see
+///        kslide_coefficient_generator
+KODO_SLIDE_API
+void kslide_decoder_factory_set_generator(kslide_decoder_factory_t* factory,
+                                          int32_t generator);
+
+/// @param factory The factory to query
+/// @return The coefficient generator of the decoders built
+KODO_SLIDE_API
+int32_t kslide_decoder_factory_generator(kslide_decoder_factory_t* factory);
+
+/// @param encoder The encoder to query
+/// @return The coefficient generator used by the encoder
+KODO_SLIDE_API
+int32_t kslide_encoder_generator(kslide_encoder_t* encoder);
+
+/// @param decoder The decoder to query
+/// @return The coefficient generator used by the decoder
+KODO_SLIDE_API
+int32_t kslide_decoder_generator(kslide_decoder_t* decoder);
+
+/// Generate the counter based coefficients of a slice of a window. The
+/// coefficients are the same as those at the same stream indices written by
+/// kslide_encoder_generate(...) with the counter based generator.
+/// @param c_field The finite field, see kslide_finite_field
+/// @param seed The seed of the coefficients
+/// @param lower_bound The stream index of the first symbol of the slice
+/// @param symbols The number of symbols in the slice
+/// @param coefficients The buffer where the coefficients will be stored. It
+///        must be large enough for the coefficients of the symbols.
+KODO_SLIDE_API
+void kslide_generate_counter_coefficients(int32_t c_field, uint64_t seed,
+                                          uint64_t lower_bound,
+                                          uint64_t symbols,
+                                          uint8_t* coefficients);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,203 @@
+// Copyright Steinwurf ApS 2018.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+
+#if defined(__unix__) || defined(__APPLE__)
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+    #define KODO_SLIDE_C_HAS_MMAP
+#endif
+
+namespace kodo_slide_c
+{
+/// A file mapped into memory. On platforms without mmap the file cannot be
+/// opened.
+class mapped_file
+{
+public:
+    mapped_file() = default;
+    mapped_file(const mapped_file&) = delete;
+    mapped_file& operator=(const mapped_file&) = delete;
+
+    ~mapped_file()
+    {
+        close();
+    }
+
+    /// Map an existing file read-only
+    /// @return false if the file could not be mapped or is empty
+    bool open_read(const char* path)
+    {
+        assert(path != nullptr);
+        assert(m_data == nullptr);
+
+#if defined(KODO_SLIDE_C_HAS_MMAP)
+        m_file = ::open(path, O_RDONLY);
+        if (m_file < 0)
+            return false;
+
+        struct stat info;
+        if (fstat(m_file, &info) != 0 || info.st_size == 0)
+        {
+            close();
+            return false;
+        }
+
+        return map(info.st_size, PROT_READ);
+#else
+        (void) path;
+        return false;
+#endif
+    }
+
+    /// Create or truncate a file of the given size and map it writable
+    /// @return false if the file could not be created or mapped
+    bool open_write(const char* path, uint64_t size)
+    {
+        assert(path != nullptr);
+        assert(m_data == nullptr);
+        assert(size > 0);
+
+#if defined(KODO_SLIDE_C_HAS_MMAP)
+        m_file = ::open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (m_file < 0)
+            return false;
+
+        if (ftruncate(m_file, size) != 0)
+        {
+            close();
+            return false;
+        }
+
+        m_writable = true;
+        return map(size, PROT_READ | PROT_WRITE);
+#else
+        (void) path;
+        (void) size;
+        return false;
+#endif
+    }
+
+    /// Flush and unmap the file. Optionally the file is truncated to the
+    /// given size first (only for writable files).
+    void close(uint64_t truncate_size = 0)
+    {
+#if defined(KODO_SLIDE_C_HAS_MMAP)
+        if (m_data != nullptr)
+        {
+            if (m_writable)
+                msync(m_data, m_size, MS_SYNC);
+
+            munmap(m_data, m_size);
+            m_data = nullptr;
+        }
+
+        if (m_file >= 0)
+        {
+            if (m_writable && truncate_size > 0 && truncate_size < m_size)
+            {
+                // The result is ignored, the padding is harmless
+                (void) ftruncate(m_file, truncate_size);
+            }
+
+            ::close(m_file);
+            m_file = -1;
+        }
+#else
+        (void) truncate_size;
+#endif
+    }
+
+    uint8_t* data() const
+    {
+        return m_data;
+    }
+
+    uint64_t size() const
+    {
+        return m_size;
+    }
+
+    /// @return The offset below which the pages have been released
+    uint64_t released() const
+    {
+        return m_released;
+    }
+
+    /// Advise the kernel that the range [begin, end) will be needed soon
+    void will_need(uint64_t begin, uint64_t end)
+    {
+        assert(m_data != nullptr);
+        begin = round_down(begin);
+        end = end < m_size ? end : m_size;
+
+#if defined(KODO_SLIDE_C_HAS_MMAP)
+        if (begin < end)
+            madvise(m_data + begin, end - begin, MADV_WILLNEED);
+#endif
+    }
+
+    /// Release the whole pages below the given offset from the resident
+    /// memory. Writable pages are flushed to the file before they are
+    /// released.
+    void release_below(uint64_t offset)
+    {
+        assert(m_data != nullptr);
+        uint64_t end = round_down(offset < m_size ? offset : m_size);
+
+        if (end <= m_released)
+            return;
+
+#if defined(KODO_SLIDE_C_HAS_MMAP)
+        uint8_t* begin = m_data + m_released;
+        if (m_writable)
+            msync(begin, end - m_released, MS_ASYNC);
+
+        madvise(begin, end - m_released, MADV_DONTNEED);
+#endif
+        m_released = end;
+    }
+
+private:
+#if defined(KODO_SLIDE_C_HAS_MMAP)
+    bool map(uint64_t size, int protection)
+    {
+        void* data = mmap(nullptr, size, protection, MAP_SHARED, m_file, 0);
+        if (data == MAP_FAILED)
+        {
+            close();
+            return false;
+        }
+
+        m_data = static_cast<uint8_t*>(data);
+        m_size = size;
+        m_page_size = sysconf(_SC_PAGESIZE);
+        madvise(m_data, m_size, MADV_SEQUENTIAL);
+        return true;
+    }
+#endif
+
+    uint64_t round_down(uint64_t offset) const
+    {
+        return offset - (offset % m_page_size);
+    }
+
+private:
+    int m_file = -1;
+    uint8_t* m_data = nullptr;
+    uint64_t m_size = 0;
+    uint64_t m_page_size = 4096;
+    bool m_writable = false;
+
+    /// Offset below which the pages have been released
+    uint64_t m_released = 0;
+};
+}
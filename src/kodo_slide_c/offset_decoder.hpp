@@ -0,0 +1,158 @@
+// Copyright Steinwurf ApS 2018.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+
+#include <kodo_slide/decoder.hpp>
+
+namespace kodo_slide_c
+{
+/// A kodo-slide decoder whose stream indices are shifted by an offset. The
+/// stream of a kodo-slide decoder can only be moved by pushing and popping
+/// symbols, so the offset lets an empty decoder continue a stream at any
+/// index in constant time, e.g. when a snapshot is restored. The interface
+/// is the one of kodo_slide::decoder with all stream indices shifted.
+class offset_decoder
+{
+public:
+
+    explicit offset_decoder(kodo_slide::decoder decoder) :
+        m_decoder(decoder)
+    { }
+
+    /// @return The wrapped decoder, e.g. to initialize it from a factory.
+    ///         Its stream indices are not shifted.
+    kodo_slide::decoder& decoder()
+    {
+        return m_decoder;
+    }
+
+    /// Moves the empty stream to start at lower_bound
+    void set_stream_lower_bound(uint64_t lower_bound)
+    {
+        assert(m_decoder.stream_symbols() == 0);
+        assert(lower_bound >= m_decoder.stream_lower_bound());
+        m_offset = lower_bound - m_decoder.stream_lower_bound();
+        m_decoder.set_window(m_decoder.stream_lower_bound(), 0);
+    }
+
+    /// Removes the offset, e.g. after the decoder is initialized again
+    void reset_offset()
+    {
+        m_offset = 0;
+    }
+
+    uint64_t symbol_size() const
+    {
+        return m_decoder.symbol_size();
+    }
+
+    uint64_t stream_symbols() const
+    {
+        return m_decoder.stream_symbols();
+    }
+
+    uint64_t stream_lower_bound() const
+    {
+        return m_decoder.stream_lower_bound() + m_offset;
+    }
+
+    uint64_t stream_upper_bound() const
+    {
+        return m_decoder.stream_upper_bound() + m_offset;
+    }
+
+    uint64_t push_front_symbol(uint8_t* symbol)
+    {
+        return m_decoder.push_front_symbol(symbol) + m_offset;
+    }
+
+    uint64_t pop_back_symbol()
+    {
+        return m_decoder.pop_back_symbol() + m_offset;
+    }
+
+    uint64_t window_symbols() const
+    {
+        return m_decoder.window_symbols();
+    }
+
+    uint64_t window_lower_bound() const
+    {
+        return m_decoder.window_lower_bound() + m_offset;
+    }
+
+    uint64_t window_upper_bound() const
+    {
+        return m_decoder.window_upper_bound() + m_offset;
+    }
+
+    void set_window(uint64_t lower_bound, uint64_t symbols)
+    {
+        assert(lower_bound >= m_offset);
+        m_decoder.set_window(lower_bound - m_offset, symbols);
+    }
+
+    uint64_t coefficient_vector_size() const
+    {
+        return m_decoder.coefficient_vector_size();
+    }
+
+    void set_seed(uint64_t seed)
+    {
+        m_decoder.set_seed(seed);
+    }
+
+    void generate(uint8_t* coefficients)
+    {
+        m_decoder.generate(coefficients);
+    }
+
+    void read_symbol(uint8_t* symbol, uint8_t* coefficients)
+    {
+        m_decoder.read_symbol(symbol, coefficients);
+    }
+
+    void read_source_symbol(uint8_t* symbol, uint64_t index)
+    {
+        assert(index >= m_offset);
+        m_decoder.read_source_symbol(symbol, index - m_offset);
+    }
+
+    uint64_t rank() const
+    {
+        return m_decoder.rank();
+    }
+
+    uint64_t symbols_missing() const
+    {
+        return m_decoder.symbols_missing();
+    }
+
+    uint64_t symbols_partially_decoded() const
+    {
+        return m_decoder.symbols_partially_decoded();
+    }
+
+    uint64_t symbols_decoded() const
+    {
+        return m_decoder.symbols_decoded();
+    }
+
+    bool is_symbol_decoded(uint64_t index) const
+    {
+        assert(index >= m_offset);
+        return m_decoder.is_symbol_decoded(index - m_offset);
+    }
+
+private:
+
+    kodo_slide::decoder m_decoder;
+    uint64_t m_offset = 0;
+};
+}
@@ -0,0 +1,132 @@
+// Copyright Steinwurf ApS 2018.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include "allocator.hpp"
+#include "coefficient_codec.hpp"
+#include "kodo_slide_c.h"
+#include "wrappers.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+
+// The symbols of the stream are all pushed with the same staging buffer as
+// their storage, so the encoder only holds one pointer per symbol. A coded
+// symbol is built one window symbol at a time: the symbol is fetched into
+// the staging buffer, multiplied by its coefficient with a write over a
+// window of that single symbol, and added to the coded symbol (addition is
+// xor in the binary extension fields).
+
+struct kslide_pull_encoder : kodo_slide_c::allocated
+{
+    kslide_encoder_t* m_encoder;
+    kslide_fetch_symbol_t m_fetch;
+    void* m_context;
+
+    /// The storage of all the stream symbols of the encoder
+    kslide_scratch m_staging;
+
+    /// The product of a fetched symbol and its coefficient
+    kslide_scratch m_product;
+};
+
+kslide_pull_encoder_t* kslide_new_pull_encoder(kslide_encoder_t* encoder,
+                                               kslide_fetch_symbol_t fetch,
+                                               void* context)
+{
+    assert(encoder != nullptr);
+    assert(fetch != nullptr);
+    assert(kslide_encoder_stream_symbols(encoder) == 0);
+
+    auto pull = new kslide_pull_encoder;
+    pull->m_encoder = encoder;
+    pull->m_fetch = fetch;
+    pull->m_context = context;
+
+    uint64_t symbol_size = kslide_encoder_symbol_size(encoder);
+    pull->m_staging.buffer(symbol_size);
+    pull->m_product.buffer(symbol_size);
+    return pull;
+}
+
+void kslide_delete_pull_encoder(kslide_pull_encoder_t* pull)
+{
+    assert(pull != nullptr);
+    delete pull;
+}
+
+uint64_t kslide_pull_encoder_push_front_symbol(kslide_pull_encoder_t* pull)
+{
+    assert(pull != nullptr);
+    return kslide_encoder_push_front_symbol(
+        pull->m_encoder, pull->m_staging.m_buffer);
+}
+
+uint64_t kslide_pull_encoder_pop_back_symbol(kslide_pull_encoder_t* pull)
+{
+    assert(pull != nullptr);
+    return kslide_encoder_pop_back_symbol(pull->m_encoder);
+}
+
+uint8_t kslide_pull_encoder_write_symbol(kslide_pull_encoder_t* pull,
+                                         uint8_t* symbol,
+                                         const uint8_t* coefficients)
+{
+    assert(pull != nullptr);
+    assert(symbol != nullptr);
+    assert(coefficients != nullptr);
+
+    kodo_slide::encoder& impl = pull->m_encoder->m_impl;
+    uint64_t symbol_size = impl.symbol_size();
+    uint32_t bits = kodo_slide_c::field_bits(pull->m_encoder->m_field);
+
+    uint64_t window_lower_bound = impl.window_lower_bound();
+    uint64_t window_symbols = impl.window_symbols();
+
+    uint8_t* staging = pull->m_staging.m_buffer;
+    uint8_t* product = pull->m_product.m_buffer;
+
+    memset(symbol, 0, symbol_size);
+
+    uint8_t ok = 1;
+    for (uint64_t i = 0; i < window_symbols; ++i)
+    {
+        uint32_t value = kodo_slide_c::get_value(bits, coefficients, i);
+        if (value == 0)
+            continue;
+
+        uint64_t index = window_lower_bound + i;
+        if (!pull->m_fetch(pull->m_context, index, staging))
+        {
+            ok = 0;
+            break;
+        }
+
+        uint8_t coefficient[2] = {0, 0};
+        kodo_slide_c::set_value(bits, coefficient, 0, value);
+        impl.set_window(index, 1);
+        impl.write_symbol(product, coefficient);
+
+        for (uint64_t j = 0; j < symbol_size; ++j)
+            symbol[j] ^= product[j];
+
+        pull->m_encoder->m_work++;
+    }
+
+    impl.set_window(window_lower_bound, window_symbols);
+    return ok;
+}
+
+uint8_t kslide_pull_encoder_write_source_symbol(kslide_pull_encoder_t* pull,
+                                                uint8_t* symbol,
+                                                uint64_t index)
+{
+    assert(pull != nullptr);
+    assert(symbol != nullptr);
+    assert(index >= kslide_encoder_stream_lower_bound(pull->m_encoder));
+    assert(index < kslide_encoder_stream_upper_bound(pull->m_encoder));
+    pull->m_encoder->m_work++;
+    return pull->m_fetch(pull->m_context, index, symbol);
+}
@@ -0,0 +1,129 @@
+// Copyright Steinwurf ApS 2018.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include "allocator.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <utility>
+
+namespace kodo_slide_c
+{
+/// A first in, first out queue stored in a circular buffer. Unlike a deque
+/// the storage only grows: popping and clearing keep the capacity, so a
+/// queue which has reached its working size no longer allocates. Popped
+/// elements stay in their slots until they are overwritten, which keeps
+/// the buffers of elements such as pending reads for reuse.
+template<class T>
+class ring
+{
+public:
+
+    bool empty() const
+    {
+        return m_size == 0;
+    }
+
+    uint64_t size() const
+    {
+        return m_size;
+    }
+
+    uint64_t capacity() const
+    {
+        return m_slots.size();
+    }
+
+    T& operator[](uint64_t index)
+    {
+        assert(index < m_size);
+        return m_slots[(m_head + index) & (m_slots.size() - 1)];
+    }
+
+    const T& operator[](uint64_t index) const
+    {
+        assert(index < m_size);
+        return m_slots[(m_head + index) & (m_slots.size() - 1)];
+    }
+
+    T& front()
+    {
+        return (*this)[0];
+    }
+
+    T& back()
+    {
+        return (*this)[m_size - 1];
+    }
+
+    /// Adds an element at the back and returns its slot
+    T& push_back(T value)
+    {
+        if (m_size == m_slots.size())
+            grow();
+
+        T& slot = m_slots[(m_head + m_size) & (m_slots.size() - 1)];
+        slot = std::move(value);
+        ++m_size;
+        return slot;
+    }
+
+    /// Adds an element at the back without assigning it and returns its
+    /// slot, so the element keeps the buffers of the last element popped
+    /// from that slot
+    T& push_back_slot()
+    {
+        if (m_size == m_slots.size())
+            grow();
+
+        ++m_size;
+        return back();
+    }
+
+    /// Removes count elements from the front
+    void pop_front(uint64_t count = 1)
+    {
+        assert(count <= m_size);
+        m_head = (m_head + count) & (m_slots.size() - 1);
+        m_size -= count;
+    }
+
+    /// Removes count elements from the back
+    void pop_back(uint64_t count = 1)
+    {
+        assert(count <= m_size);
+        m_size -= count;
+    }
+
+    void clear()
+    {
+        m_head = 0;
+        m_size = 0;
+    }
+
+private:
+
+    /// Doubles the capacity, the capacity is always a power of two
+    void grow()
+    {
+        uint64_t capacity = m_slots.empty() ? 16 : 2 * m_slots.size();
+
+        vector<T> slots(capacity);
+        for (uint64_t i = 0; i < m_size; ++i)
+            slots[i] = std::move((*this)[i]);
+
+        m_slots.swap(slots);
+        m_head = 0;
+    }
+
+private:
+
+    vector<T> m_slots;
+    uint64_t m_head = 0;
+    uint64_t m_size = 0;
+};
+}
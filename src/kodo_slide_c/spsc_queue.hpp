@@ -0,0 +1,116 @@
+// Copyright Steinwurf ApS 2018.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include "allocator.hpp"
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+
+namespace kodo_slide_c
+{
+/// Lock-free bounded queue for a single producer and a single consumer.
+///
+/// The slots are allocated up front and are written and read in place, so
+/// slots owning large buffers are reused without any allocations:
+///
+///     T* slot = queue.write_slot(); // Producer
+///     if (slot != nullptr) { ...; queue.commit_write(); }
+///
+///     T* slot = queue.read_slot(); // Consumer
+///     if (slot != nullptr) { ...; queue.commit_read(); }
+///
+template<class T>
+class spsc_queue
+{
+public:
+    /// @param capacity The maximum number of elements in the queue
+    spsc_queue(uint64_t capacity) :
+        m_slots(capacity + 1)
+    {
+        assert(capacity > 0);
+    }
+
+    /// @return The maximum number of elements in the queue
+    uint64_t capacity() const
+    {
+        return m_slots.size() - 1;
+    }
+
+    /// @return The slot at the given position, used to initialize the slots
+    T& slot(uint64_t index)
+    {
+        assert(index < m_slots.size());
+        return m_slots[index];
+    }
+
+    /// @return The number of slots, including the one always kept free
+    uint64_t slots() const
+    {
+        return m_slots.size();
+    }
+
+    /// @return The next free slot or nullptr if the queue is full
+    T* write_slot()
+    {
+        uint64_t tail = m_tail.load(std::memory_order_relaxed);
+        if (next(tail) == m_head.load(std::memory_order_acquire))
+            return nullptr;
+
+        return &m_slots[tail];
+    }
+
+    /// Make the slot returned by write_slot() available to the consumer
+    void commit_write()
+    {
+        uint64_t tail = m_tail.load(std::memory_order_relaxed);
+        m_tail.store(next(tail), std::memory_order_release);
+    }
+
+    /// @return The oldest element or nullptr if the queue is empty
+    T* read_slot()
+    {
+        uint64_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tail.load(std::memory_order_acquire))
+            return nullptr;
+
+        return &m_slots[head];
+    }
+
+    /// Release the slot returned by read_slot() to the producer
+    void commit_read()
+    {
+        uint64_t head = m_head.load(std::memory_order_relaxed);
+        m_head.store(next(head), std::memory_order_release);
+    }
+
+    /// @return true if the queue is empty
+    bool empty() const
+    {
+        return m_head.load(std::memory_order_acquire) ==
+               m_tail.load(std::memory_order_acquire);
+    }
+
+private:
+    uint64_t next(uint64_t index) const
+    {
+        return index + 1 == m_slots.size() ? 0 : index + 1;
+    }
+
+private:
+    kodo_slide_c::vector<T> m_slots;
+
+    // The head and tail are kept on separate cache lines to avoid false
+    // sharing between the producer and the consumer. Padding is used rather
+    // than alignas() since over-aligned new is not available in C++14.
+    uint8_t m_padding0[64];
+    std::atomic<uint64_t> m_head{0};
+    uint8_t m_padding1[64];
+    std::atomic<uint64_t> m_tail{0};
+    uint8_t m_padding2[64];
+};
+}
@@ -0,0 +1,132 @@
+// Copyright Steinwurf ApS 2018.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include "trace.hpp"
+#include "kodo_slide_c.h"
+#include "wrappers.hpp"
+
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+
+namespace kodo_slide_c
+{
+void trace_ring::set_capacity(uint64_t capacity)
+{
+    m_events.assign(capacity, kslide_trace_event());
+    m_next = 0;
+    m_size = 0;
+}
+
+void trace_ring::push(int32_t type, uint64_t index, uint64_t symbols,
+                      uint64_t rank, uint64_t value, uint32_t innovative)
+{
+    kslide_trace_event& event = m_events[m_next];
+    event.m_time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    event.m_type = type;
+    event.m_index = index;
+    event.m_symbols = symbols;
+    event.m_rank = rank;
+    event.m_value = value;
+    event.m_innovative = innovative;
+
+    m_next = m_next + 1 == m_events.size() ? 0 : m_next + 1;
+    if (m_size < m_events.size())
+        ++m_size;
+}
+
+void trace_ring::copy(kslide_trace_event* events) const
+{
+    if (m_size == 0)
+        return;
+
+    uint64_t first = (m_next + m_events.size() - m_size) % m_events.size();
+    for (uint64_t i = 0; i < m_size; ++i)
+        events[i] = m_events[(first + i) % m_events.size()];
+}
+
+bool trace_ring::dump(const char* path) const
+{
+    FILE* file = fopen(path, "wb");
+    if (file == nullptr)
+        return false;
+
+    kslide_trace_header header;
+    header.m_magic = kslide_trace_magic;
+    header.m_version = kslide_trace_version;
+    header.m_events = m_size;
+
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1;
+
+    if (ok && m_size > 0)
+    {
+        kodo_slide_c::vector<kslide_trace_event> events(m_size);
+        copy(events.data());
+        ok = fwrite(events.data(), sizeof(kslide_trace_event), m_size,
+                    file) == m_size;
+    }
+
+    return fclose(file) == 0 && ok;
+}
+}
+
+//------------------------------------------------------------------
+// TRACE API
+//------------------------------------------------------------------
+
+void kslide_encoder_set_trace(kslide_encoder_t* encoder, uint64_t events)
+{
+    assert(encoder != nullptr);
+    encoder->m_trace.set_capacity(events);
+}
+
+uint64_t kslide_encoder_trace_events(kslide_encoder_t* encoder)
+{
+    assert(encoder != nullptr);
+    return encoder->m_trace.size();
+}
+
+void kslide_encoder_copy_trace(kslide_encoder_t* encoder,
+                               kslide_trace_event* events)
+{
+    assert(encoder != nullptr);
+    assert(events != nullptr || encoder->m_trace.size() == 0);
+    encoder->m_trace.copy(events);
+}
+
+uint8_t kslide_encoder_dump_trace(kslide_encoder_t* encoder, const char* path)
+{
+    assert(encoder != nullptr);
+    assert(path != nullptr);
+    return encoder->m_trace.dump(path) ? 1 : 0;
+}
+
+void kslide_decoder_set_trace(kslide_decoder_t* decoder, uint64_t events)
+{
+    assert(decoder != nullptr);
+    decoder->m_trace.set_capacity(events);
+}
+
+uint64_t kslide_decoder_trace_events(kslide_decoder_t* decoder)
+{
+    assert(decoder != nullptr);
+    return decoder->m_trace.size();
+}
+
+void kslide_decoder_copy_trace(kslide_decoder_t* decoder,
+                               kslide_trace_event* events)
+{
+    assert(decoder != nullptr);
+    assert(events != nullptr || decoder->m_trace.size() == 0);
+    decoder->m_trace.copy(events);
+}
+
+uint8_t kslide_decoder_dump_trace(kslide_decoder_t* decoder, const char* path)
+{
+    assert(decoder != nullptr);
+    assert(path != nullptr);
+    return decoder->m_trace.dump(path) ? 1 : 0;
+}
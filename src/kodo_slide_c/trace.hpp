@@ -0,0 +1,64 @@
+// Copyright Steinwurf ApS 2018.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include "allocator.hpp"
+#include "kodo_slide_c.h"
+
+#include <cstdint>
+
+namespace kodo_slide_c
+{
+/// Ring buffer of the most recent coding events of an encoder or decoder.
+/// Recording is a branch when the trace is disabled and a clock read and a
+/// store when it is enabled. When the ring is full the oldest events are
+/// overwritten.
+class trace_ring
+{
+public:
+    /// Sets the number of events kept, 0 disables the trace. Any recorded
+    /// events are discarded.
+    void set_capacity(uint64_t capacity);
+
+    /// @return true if events are recorded
+    bool enabled() const
+    {
+        return !m_events.empty();
+    }
+
+    /// Records an event if the trace is enabled. Callers check enabled()
+    /// first when the arguments are not free to compute.
+    void record(int32_t type, uint64_t index, uint64_t symbols,
+                uint64_t rank = 0, uint64_t value = 0,
+                uint32_t innovative = 0)
+    {
+        if (enabled())
+            push(type, index, symbols, rank, value, innovative);
+    }
+
+    /// @return The number of recorded events
+    uint64_t size() const
+    {
+        return m_size;
+    }
+
+    /// Copies the recorded events, oldest first
+    void copy(kslide_trace_event* events) const;
+
+    /// Writes the trace file, see kslide_trace_header
+    /// @return true if the file was written
+    bool dump(const char* path) const;
+
+private:
+    void push(int32_t type, uint64_t index, uint64_t symbols, uint64_t rank,
+              uint64_t value, uint32_t innovative);
+
+private:
+    kodo_slide_c::vector<kslide_trace_event> m_events;
+    uint64_t m_next = 0;
+    uint64_t m_size = 0;
+};
+}
@@ -0,0 +1,337 @@
+// Copyright Steinwurf ApS 2018.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include "allocator.hpp"
+#include "kodo_slide_c.h"
+#include "offset_decoder.hpp"
+#include "ring.hpp"
+#include "trace.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <utility>
+
+#include <kodo_slide/encoder.hpp>
+#include <kodo_slide/decoder.hpp>
+
+// The definitions of the opaque types of the C API, shared by the
+// translation units which need access to the wrapped kodo-slide objects.
+
+namespace kodo_slide_c
+{
+/// The alignment of buffers for the aligned copy, see
+/// kslide_preferred_alignment()
+const uint64_t preferred_alignment = 64;
+
+/// @return true if the buffer has the preferred alignment
+inline bool is_aligned(const void* data)
+{
+    return reinterpret_cast<uintptr_t>(data) % preferred_alignment == 0;
+}
+}
+
+struct kslide_scratch : kodo_slide_c::allocated
+{
+    kslide_scratch() = default;
+    kslide_scratch(const kslide_scratch&) = delete;
+    kslide_scratch& operator=(const kslide_scratch&) = delete;
+
+    kslide_scratch(kslide_scratch&& other) noexcept :
+        m_buffer(other.m_buffer),
+        m_size(other.m_size)
+    {
+        other.m_buffer = nullptr;
+        other.m_size = 0;
+    }
+
+    kslide_scratch& operator=(kslide_scratch&& other) noexcept
+    {
+        std::swap(m_buffer, other.m_buffer);
+        std::swap(m_size, other.m_size);
+        return *this;
+    }
+
+    ~kslide_scratch()
+    {
+        kodo_slide_c::deallocate(m_buffer);
+    }
+
+    /// Returns a buffer of at least size bytes. The buffer is only valid
+    /// until the next call, and it only grows.
+    uint8_t* buffer(uint64_t size)
+    {
+        if (m_size < size)
+        {
+            kodo_slide_c::deallocate(m_buffer);
+            m_buffer = static_cast<uint8_t*>(
+                kodo_slide_c::allocate_aligned(
+                    kodo_slide_c::preferred_alignment, size));
+            assert(m_buffer != nullptr);
+            m_size = size;
+        }
+        return m_buffer;
+    }
+
+    /// The buffer with the preferred alignment
+    uint8_t* m_buffer = nullptr;
+    uint64_t m_size = 0;
+};
+
+/// A symbol in the stream of a decoder
+struct stream_symbol
+{
+    /// The storage of the symbol
+    uint8_t* m_data;
+
+    /// The deadline of the symbol, see kslide_decoder_expire(...)
+    uint64_t m_deadline;
+};
+
+/// A coded symbol read by a decoder which has not been applied yet, see
+/// kslide_decoder_set_read_budget(...)
+struct pending_read
+{
+    /// The window of the decoder when the symbol was read
+    uint64_t m_window_lower_bound;
+    uint64_t m_window_symbols;
+
+    /// The symbol, in an aligned buffer so the aligned copy is not needed
+    kslide_scratch m_symbol;
+    kodo_slide_c::vector<uint8_t> m_coefficients;
+};
+
+struct kslide_decoder : kodo_slide_c::allocated
+{
+    kslide_decoder(kodo_slide::decoder decoder, int32_t field) :
+        m_impl(decoder),
+        m_field(field)
+    { }
+    kodo_slide_c::offset_decoder m_impl;
+
+    /// The finite field used by the decoder, see kslide_finite_field
+    int32_t m_field;
+
+    /// The coefficient generator, see kslide_coefficient_generator
+    int32_t m_generator = kslide_generator_default;
+
+    /// The last seed set, used by the counter based generator
+    uint64_t m_seed = 0;
+
+    /// If true the window follows the stream on every push and pop
+    bool m_track_stream = false;
+
+    /// The number of symbols in a block, or 0 if block mode is disabled
+    uint64_t m_block_symbols = 0;
+
+    /// The symbols currently in the stream, starting from the stream lower
+    /// bound. Used to access the decoded data of the stream.
+    kodo_slide_c::ring<stream_symbol> m_symbols;
+
+    /// The file sink providing the storage of the stream, or nullptr. See
+    /// kslide_new_file_sink(...)
+    kslide_file_sink* m_file_sink = nullptr;
+
+    /// The scratch arena for transient buffers of the C API, or nullptr to
+    /// use m_own_scratch
+    kslide_scratch* m_scratch = nullptr;
+    kslide_scratch m_own_scratch;
+
+    /// The recent coding events, see kslide_decoder_set_trace(...)
+    kodo_slide_c::trace_ring m_trace;
+
+    /// The number of stream symbols without the preferred alignment
+    uint64_t m_unaligned_symbols = 0;
+
+    /// If true unaligned symbols are copied to an aligned buffer, see
+    /// kslide_decoder_set_aligned_copy(...)
+    bool m_aligned_copy = false;
+
+    /// Aligned copy of a symbol read from an unaligned buffer
+    kslide_scratch m_aligned_symbol;
+
+    /// The work allowed per read, or 0 to apply reads right away. See
+    /// kslide_decoder_set_read_budget(...)
+    uint64_t m_read_budget = 0;
+
+    /// The symbols read but not applied yet, oldest first
+    /// The slots keep their buffers, so the buffers of pending reads are
+    /// reused
+    kodo_slide_c::ring<pending_read> m_pending_reads;
+
+    /// The largest number of pending reads, see
+    /// kslide_decoder_set_max_pending_reads(...)
+    uint64_t m_max_pending_reads = 1024;
+
+    /// The number of reads dropped without being applied
+    uint64_t m_dropped_reads = 0;
+
+    /// All symbols from the stream lower bound up to this index were
+    /// decoded when last checked. Decoded symbols stay decoded until they
+    /// are popped, so the index only moves forward.
+    uint64_t m_decoded_prefix = 0;
+
+    /// The work done since the last kslide_decoder_reset_work(...), in symbol
+    /// operations
+    uint64_t m_work = 0;
+
+    /// The work quota, or 0 for no quota. See kslide_decoder_set_work_quota(...)
+    uint64_t m_work_quota = 0;
+};
+
+struct kslide_decoder_factory : kodo_slide_c::allocated
+{
+    kodo_slide::decoder::factory m_impl;
+
+    /// The coefficient generator of the coders built
+    int32_t m_generator = kslide_generator_default;
+};
+
+struct kslide_encoder : kodo_slide_c::allocated
+{
+    kslide_encoder(kodo_slide::encoder encoder, int32_t field) :
+        m_impl(encoder),
+        m_field(field)
+    { }
+    kodo_slide::encoder m_impl;
+
+    /// The finite field used by the encoder, see kslide_finite_field
+    int32_t m_field;
+
+    /// The coefficient generator, see kslide_coefficient_generator
+    int32_t m_generator = kslide_generator_default;
+
+    /// The last seed set, used by the counter based generator
+    uint64_t m_seed = 0;
+
+    /// If true the window follows the stream on every push and pop
+    bool m_track_stream = false;
+
+    /// The number of symbols in a block, or 0 if block mode is disabled
+    uint64_t m_block_symbols = 0;
+
+    /// The file source providing the symbols of the stream, or nullptr. See
+    /// kslide_new_file_source(...)
+    kslide_file_source* m_file_source = nullptr;
+
+    /// The scratch arena for transient buffers of the C API, or nullptr to
+    /// use m_own_scratch
+    kslide_scratch* m_scratch = nullptr;
+    kslide_scratch m_own_scratch;
+
+    /// The recent coding events, see kslide_encoder_set_trace(...)
+    kodo_slide_c::trace_ring m_trace;
+
+    /// The indices of the stream symbols without the preferred alignment
+    kodo_slide_c::ring<uint64_t> m_unaligned_symbols;
+
+    /// If true unaligned symbols are written through an aligned buffer, see
+    /// kslide_encoder_set_aligned_copy(...)
+    bool m_aligned_copy = false;
+
+    /// Aligned buffer for a symbol written to an unaligned buffer
+    kslide_scratch m_aligned_symbol;
+
+    /// The number of running repair symbols, see
+    /// kslide_encoder_set_accumulators(...)
+    uint64_t m_accumulators = 0;
+
+    /// The running repair symbols, one after the other
+    kodo_slide_c::vector<uint8_t> m_accumulator_symbols;
+
+    /// The coefficients of the stream symbols in the running repair
+    /// symbols, m_accumulators per stream symbol starting from the stream
+    /// lower bound
+    kodo_slide_c::ring<uint16_t> m_accumulator_coefficients;
+
+    /// The state of the generator of the accumulator coefficients
+    uint64_t m_accumulator_state = 0;
+
+    /// The decoded prefix upper bound of the last feedback, see
+    /// kslide_encoder_read_feedback(...)
+    uint64_t m_feedback_prefix = 0;
+
+    /// The number of symbols in the bitmap of the last feedback
+    uint64_t m_feedback_symbols = 0;
+
+    /// The number of symbols missing at the decoder in the last feedback
+    uint64_t m_feedback_missing = 0;
+
+    /// The decoded bitmap of the last feedback, starting at the prefix
+    kodo_slide_c::vector<uint8_t> m_feedback_decoded;
+
+    /// The work done since the last kslide_encoder_reset_work(...), in symbol
+    /// operations
+    uint64_t m_work = 0;
+
+    /// The work quota, or 0 for no quota. See kslide_encoder_set_work_quota(...)
+    uint64_t m_work_quota = 0;
+};
+
+struct kslide_encoder_factory : kodo_slide_c::allocated
+{
+    kodo_slide::encoder::factory m_impl;
+
+    /// The coefficient generator of the coders built
+    int32_t m_generator = kslide_generator_default;
+};
+
+/// Sets the window of a coder to cover its entire stream
+template<class Coder>
+void update_tracked_window(Coder& coder)
+{
+    if (coder.window_lower_bound() != coder.stream_lower_bound() ||
+        coder.window_symbols() != coder.stream_symbols())
+    {
+        coder.set_window(coder.stream_lower_bound(), coder.stream_symbols());
+    }
+}
+
+/// Sets the window of a coder to cover the symbols of the block of the
+/// newest stream symbol which are still in the stream
+template<class Coder>
+void update_block_window(Coder& coder, uint64_t block_symbols)
+{
+    uint64_t lower_bound = coder.stream_lower_bound();
+    uint64_t upper_bound = coder.stream_upper_bound();
+
+    if (upper_bound > lower_bound)
+    {
+        uint64_t block_start =
+            ((upper_bound - 1) / block_symbols) * block_symbols;
+        lower_bound = std::max(lower_bound, block_start);
+    }
+
+    if (coder.window_lower_bound() != lower_bound ||
+        coder.window_symbols() != upper_bound - lower_bound)
+    {
+        coder.set_window(lower_bound, upper_bound - lower_bound);
+    }
+}
+
+/// Forgets the last feedback read by an encoder
+inline void reset_feedback(kslide_encoder& encoder)
+{
+    encoder.m_feedback_prefix = 0;
+    encoder.m_feedback_symbols = 0;
+    encoder.m_feedback_missing = 0;
+    encoder.m_feedback_decoded.clear();
+}
+
+/// Returns a transient buffer of at least size bytes from the scratch arena
+/// of a coder
+template<class Coder>
+uint8_t* scratch_buffer(Coder& coder, uint64_t size)
+{
+    kslide_scratch* scratch =
+        coder.m_scratch != nullptr ? coder.m_scratch : &coder.m_own_scratch;
+    return scratch->buffer(size);
+}
+
+int32_t kslide_field_to_c_field(kodo_slide::finite_field field_id);
+
+kodo_slide::finite_field c_field_to_kslide_field(int32_t c_field);
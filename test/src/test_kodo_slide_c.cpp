@@ -6,6 +6,7 @@
 #include <kodo_slide_c/kodo_slide_c.h>
 
 #include <algorithm>
+#include <thread>
 #include <vector>
 
 #include <gtest/gtest.h>
@@ -704,3 +705,2650 @@ TEST(test_code, mix_coded_uncoded)
     mix_coded_uncoded(kslide_binary8);
     mix_coded_uncoded(kslide_binary16);
 }
+
+TEST(test_kodo_slide_c, decoder_snapshot)
+{
+    srand(time(0));
+
+    uint64_t symbols = 20U;
+    uint64_t symbol_size = 100U;
+
+    kslide_decoder_factory_t* decoder_factory = kslide_new_decoder_factory();
+    kslide_encoder_factory_t* encoder_factory = kslide_new_encoder_factory();
+
+    kslide_decoder_factory_set_symbol_size(decoder_factory, symbol_size);
+    kslide_encoder_factory_set_symbol_size(encoder_factory, symbol_size);
+
+    kslide_decoder_t* decoder = kslide_decoder_factory_build(decoder_factory);
+    kslide_encoder_t* encoder = kslide_encoder_factory_build(encoder_factory);
+
+    symbol_storage* encoder_storage = symbol_storage_alloc(symbols, symbol_size);
+    symbol_storage* decoder_storage = symbol_storage_alloc(symbols, symbol_size);
+    symbol_storage_randomize(encoder_storage);
+
+    for (uint64_t i = 0; i < symbols; ++i)
+    {
+        kslide_encoder_push_front_symbol(
+            encoder, symbol_storage_symbol(encoder_storage, i));
+        kslide_decoder_push_front_symbol(
+            decoder, symbol_storage_symbol(decoder_storage, i));
+    }
+
+    // Pop a few symbols to get a non-zero lower bound
+    for (uint64_t i = 0; i < 5; ++i)
+    {
+        kslide_encoder_pop_back_symbol(encoder);
+        kslide_decoder_pop_back_symbol(decoder);
+    }
+
+    uint8_t* symbol = (uint8_t*) malloc(symbol_size);
+
+    // Deliver every other source symbol before taking the snapshot
+    for (uint64_t i = 5; i < symbols; i += 2)
+    {
+        kslide_encoder_write_source_symbol(encoder, symbol, i);
+        kslide_decoder_read_source_symbol(decoder, symbol, i);
+    }
+
+    uint64_t decoded = kslide_decoder_symbols_decoded(decoder);
+    EXPECT_EQ(8U, decoded);
+
+    std::vector<uint8_t> snapshot(kslide_decoder_snapshot_size(decoder));
+    kslide_decoder_snapshot(decoder, snapshot.data());
+
+    EXPECT_EQ(5U, kslide_decoder_snapshot_stream_lower_bound(snapshot.data()));
+    EXPECT_EQ(15U, kslide_decoder_snapshot_stream_symbols(snapshot.data()));
+
+    // Restore the snapshot in a new decoder with its own storage
+    kslide_decoder_t* standby = kslide_decoder_factory_build(decoder_factory);
+    symbol_storage* standby_storage = symbol_storage_alloc(symbols, symbol_size);
+
+    std::vector<uint8_t*> standby_symbols;
+    for (uint64_t i = 5; i < symbols; ++i)
+    {
+        standby_symbols.push_back(symbol_storage_symbol(standby_storage, i));
+    }
+
+    // A truncated snapshot is rejected without changing the decoder
+    for (uint64_t size : { (uint64_t) 0U, (uint64_t) 16U,
+                           (uint64_t) snapshot.size() - symbol_size,
+                           (uint64_t) snapshot.size() - 1 })
+    {
+        EXPECT_EQ(0U, kslide_decoder_restore(
+            standby, snapshot.data(), size, standby_symbols.data()));
+        EXPECT_EQ(0U, kslide_decoder_stream_symbols(standby));
+        EXPECT_EQ(0U, kslide_decoder_stream_lower_bound(standby));
+    }
+
+    // So is a snapshot with more stream symbols than the buffer holds
+    std::vector<uint8_t> corrupt(snapshot);
+    uint64_t too_many = 100000U;
+    memcpy(corrupt.data() + 24, &too_many, sizeof(too_many));
+    EXPECT_EQ(0U, kslide_decoder_restore(
+        standby, corrupt.data(), corrupt.size(), standby_symbols.data()));
+    EXPECT_EQ(0U, kslide_decoder_stream_symbols(standby));
+
+    EXPECT_EQ(1U, kslide_decoder_restore(
+        standby, snapshot.data(), snapshot.size(), standby_symbols.data()));
+
+    EXPECT_EQ(5U, kslide_decoder_stream_lower_bound(standby));
+    EXPECT_EQ(15U, kslide_decoder_stream_symbols(standby));
+    EXPECT_EQ(decoded, kslide_decoder_symbols_decoded(standby));
+
+    // Restoring into a decoder which is in use must fail
+    EXPECT_EQ(0U, kslide_decoder_restore(
+        decoder, snapshot.data(), snapshot.size(), standby_symbols.data()));
+
+    // The snapshot does not have to be aligned
+    std::vector<uint8_t> unaligned(snapshot.size() + 1);
+    memcpy(unaligned.data() + 1, snapshot.data(), snapshot.size());
+    EXPECT_EQ(5U, kslide_decoder_snapshot_stream_lower_bound(
+        unaligned.data() + 1));
+    EXPECT_EQ(15U, kslide_decoder_snapshot_stream_symbols(
+        unaligned.data() + 1));
+
+    symbol_storage* other_storage = symbol_storage_alloc(symbols, symbol_size);
+    std::vector<uint8_t*> other_symbols;
+    for (uint64_t i = 5; i < symbols; ++i)
+        other_symbols.push_back(symbol_storage_symbol(other_storage, i));
+
+    kslide_decoder_t* other = kslide_decoder_factory_build(decoder_factory);
+    EXPECT_EQ(1U, kslide_decoder_restore(
+        other, unaligned.data() + 1, snapshot.size(), other_symbols.data()));
+    EXPECT_EQ(5U, kslide_decoder_stream_lower_bound(other));
+    EXPECT_EQ(20U, kslide_decoder_stream_upper_bound(other));
+    EXPECT_EQ(1U, kslide_decoder_is_symbol_decoded(other, 7));
+    EXPECT_EQ(0U, kslide_decoder_is_symbol_decoded(other, 6));
+    EXPECT_EQ(5U, kslide_decoder_pop_back_symbol(other));
+
+    // A reset decoder starts from index zero again
+    kslide_decoder_reset(other);
+    EXPECT_EQ(0U, kslide_decoder_stream_lower_bound(other));
+    EXPECT_EQ(0U, kslide_decoder_push_front_symbol(
+        other, symbol_storage_symbol(other_storage, 0)));
+    kslide_delete_decoder(other);
+    symbol_storage_free(other_storage);
+
+    // Continue decoding on the standby decoder
+    kslide_encoder_set_window(encoder, 5, 15);
+    kslide_decoder_set_window(standby, 5, 15);
+
+    uint8_t* coefficients = (uint8_t*) malloc(
+        kslide_encoder_coefficient_vector_size(encoder));
+
+    uint32_t iterations = 0U;
+    while (kslide_decoder_symbols_decoded(standby) < 15U && iterations < 100U)
+    {
+        kslide_encoder_set_seed(encoder, rand());
+        kslide_encoder_generate(encoder, coefficients);
+        kslide_encoder_write_symbol(encoder, symbol, coefficients);
+        kslide_decoder_read_symbol(standby, symbol, coefficients);
+        ++iterations;
+    }
+
+    EXPECT_EQ(15U, kslide_decoder_symbols_decoded(standby));
+
+    for (uint64_t i = 5; i < symbols; ++i)
+    {
+        EXPECT_EQ(0, memcmp(symbol_storage_symbol(encoder_storage, i),
+                            symbol_storage_symbol(standby_storage, i),
+                            symbol_size));
+    }
+
+    free(coefficients);
+    free(symbol);
+
+    kslide_delete_decoder(standby);
+    kslide_delete_decoder(decoder);
+    kslide_delete_encoder(encoder);
+
+    symbol_storage_free(standby_storage);
+    symbol_storage_free(decoder_storage);
+    symbol_storage_free(encoder_storage);
+
+    kslide_delete_decoder_factory(decoder_factory);
+    kslide_delete_encoder_factory(encoder_factory);
+}
+
+TEST(test_kodo_slide_c, track_stream)
+{
+    srand(time(0));
+
+    uint64_t symbols = 50U;
+    uint64_t symbol_size = 100U;
+
+    kslide_decoder_factory_t* decoder_factory = kslide_new_decoder_factory();
+    kslide_encoder_factory_t* encoder_factory = kslide_new_encoder_factory();
+
+    kslide_decoder_factory_set_symbol_size(decoder_factory, symbol_size);
+    kslide_encoder_factory_set_symbol_size(encoder_factory, symbol_size);
+
+    kslide_decoder_t* decoder = kslide_decoder_factory_build(decoder_factory);
+    kslide_encoder_t* encoder = kslide_encoder_factory_build(encoder_factory);
+
+    EXPECT_EQ(0U, kslide_encoder_track_stream(encoder));
+    EXPECT_EQ(0U, kslide_decoder_track_stream(decoder));
+
+    kslide_encoder_set_track_stream(encoder, 1);
+    kslide_decoder_set_track_stream(decoder, 1);
+
+    EXPECT_EQ(1U, kslide_encoder_track_stream(encoder));
+    EXPECT_EQ(1U, kslide_decoder_track_stream(decoder));
+
+    symbol_storage* encoder_storage = symbol_storage_alloc(symbols, symbol_size);
+    symbol_storage* decoder_storage = symbol_storage_alloc(symbols, symbol_size);
+    symbol_storage_randomize(encoder_storage);
+
+    uint8_t* symbol = (uint8_t*) malloc(symbol_size);
+    uint8_t* coefficients = (uint8_t*) malloc(symbols);
+
+    uint32_t decoded = 0;
+
+    for (uint64_t i = 0; i < symbols; ++i)
+    {
+        kslide_encoder_push_front_symbol(
+            encoder, symbol_storage_symbol(encoder_storage, i));
+        kslide_decoder_push_front_symbol(
+            decoder, symbol_storage_symbol(decoder_storage, i));
+
+        // Keep at most 5 symbols in the streams
+        if (kslide_encoder_stream_symbols(encoder) > 5U)
+        {
+            uint64_t index = kslide_decoder_stream_lower_bound(decoder);
+            decoded += kslide_decoder_is_symbol_decoded(decoder, index);
+
+            kslide_encoder_pop_back_symbol(encoder);
+            kslide_decoder_pop_back_symbol(decoder);
+        }
+
+        EXPECT_EQ(kslide_encoder_stream_lower_bound(encoder),
+                  kslide_encoder_window_lower_bound(encoder));
+        EXPECT_EQ(kslide_encoder_stream_symbols(encoder),
+                  kslide_encoder_window_symbols(encoder));
+        EXPECT_EQ(kslide_encoder_window_lower_bound(encoder),
+                  kslide_decoder_window_lower_bound(decoder));
+        EXPECT_EQ(kslide_encoder_window_symbols(encoder),
+                  kslide_decoder_window_symbols(decoder));
+
+        // Send two coded symbols per source symbol without touching the
+        // windows
+        for (uint32_t j = 0; j < 2; ++j)
+        {
+            uint64_t seed = rand();
+            kslide_encoder_set_seed(encoder, seed);
+            kslide_encoder_generate(encoder, coefficients);
+            kslide_encoder_write_symbol(encoder, symbol, coefficients);
+
+            kslide_decoder_set_seed(decoder, seed);
+            kslide_decoder_generate(decoder, coefficients);
+            kslide_decoder_read_symbol(decoder, symbol, coefficients);
+        }
+    }
+
+    EXPECT_GE(decoded, 40U);
+
+    // Without tracking the window is left untouched
+    kslide_encoder_set_track_stream(encoder, 0);
+    kslide_encoder_push_front_symbol(encoder, symbol);
+    EXPECT_EQ(5U, kslide_encoder_window_symbols(encoder));
+    EXPECT_EQ(6U, kslide_encoder_stream_symbols(encoder));
+
+    free(coefficients);
+    free(symbol);
+
+    kslide_delete_decoder(decoder);
+    kslide_delete_encoder(encoder);
+
+    symbol_storage_free(decoder_storage);
+    symbol_storage_free(encoder_storage);
+
+    kslide_delete_decoder_factory(decoder_factory);
+    kslide_delete_encoder_factory(encoder_factory);
+}
+
+TEST(test_kodo_slide_c, decoder_pipeline)
+{
+    srand(time(0));
+
+    uint64_t symbols = 40U;
+    uint64_t symbol_size = 100U;
+
+    kslide_decoder_factory_t* decoder_factory = kslide_new_decoder_factory();
+    kslide_encoder_factory_t* encoder_factory = kslide_new_encoder_factory();
+
+    kslide_decoder_factory_set_symbol_size(decoder_factory, symbol_size);
+    kslide_encoder_factory_set_symbol_size(encoder_factory, symbol_size);
+
+    kslide_decoder_t* decoder = kslide_decoder_factory_build(decoder_factory);
+    kslide_encoder_t* encoder = kslide_encoder_factory_build(encoder_factory);
+
+    symbol_storage* encoder_storage = symbol_storage_alloc(symbols, symbol_size);
+    symbol_storage* decoder_storage = symbol_storage_alloc(symbols, symbol_size);
+    symbol_storage_randomize(encoder_storage);
+
+    for (uint64_t i = 0; i < symbols; ++i)
+    {
+        kslide_encoder_push_front_symbol(
+            encoder, symbol_storage_symbol(encoder_storage, i));
+    }
+    kslide_encoder_set_window(encoder, 0, symbols);
+
+    // Use a small queue to exercise the full queue handling
+    kslide_decoder_pipeline_t* pipeline =
+        kslide_new_decoder_pipeline(decoder, 4, symbols);
+
+    // The producer delivers every other symbol systematically followed by
+    // coded symbols, and finally pops the entire stream
+    std::thread producer([&]()
+    {
+        std::vector<uint8_t> symbol(symbol_size);
+        std::vector<uint8_t> coefficients(symbols);
+
+        for (uint64_t i = 0; i < symbols; ++i)
+        {
+            while (!kslide_decoder_pipeline_push_front_symbol(
+                pipeline, symbol_storage_symbol(decoder_storage, i)))
+            { std::this_thread::yield(); }
+        }
+
+        for (uint64_t i = 0; i < symbols; i += 2)
+        {
+            kslide_encoder_write_source_symbol(encoder, symbol.data(), i);
+            while (!kslide_decoder_pipeline_read_source_symbol(
+                pipeline, symbol.data(), i))
+            { std::this_thread::yield(); }
+        }
+
+        for (uint64_t i = 0; i < symbols; ++i)
+        {
+            if (i % 2)
+            {
+                kslide_encoder_set_seed(encoder, i);
+                kslide_encoder_generate(encoder, coefficients.data());
+                kslide_encoder_write_symbol(
+                    encoder, symbol.data(), coefficients.data());
+
+                while (!kslide_decoder_pipeline_read_seeded_symbol(
+                    pipeline, 0, symbols, symbol.data(), i))
+                { std::this_thread::yield(); }
+            }
+            else
+            {
+                kslide_encoder_set_seed(encoder, i);
+                kslide_encoder_generate(encoder, coefficients.data());
+                kslide_encoder_write_symbol(
+                    encoder, symbol.data(), coefficients.data());
+
+                while (!kslide_decoder_pipeline_read_symbol(
+                    pipeline, 0, symbols, symbol.data(), coefficients.data(),
+                    kslide_encoder_coefficient_vector_size(encoder)))
+                { std::this_thread::yield(); }
+            }
+        }
+
+        for (uint64_t i = 0; i < symbols; ++i)
+        {
+            while (!kslide_decoder_pipeline_pop_back_symbol(pipeline))
+            { std::this_thread::yield(); }
+        }
+    });
+
+    std::vector<uint32_t> decoded(symbols, 0);
+    uint64_t popped = 0;
+    uint32_t polls = 0;
+
+    while (popped < symbols && polls < 10000000U)
+    {
+        kslide_pipeline_event event;
+        if (!kslide_decoder_pipeline_poll(pipeline, &event))
+        {
+            ++polls;
+            std::this_thread::yield();
+            continue;
+        }
+
+        // The producer must be joined, so the test continues on failure
+        EXPECT_LT(event.m_index, symbols);
+        if (event.m_index >= symbols)
+            continue;
+
+        if (event.m_type == kslide_pipeline_symbol_decoded)
+        {
+            ++decoded[event.m_index];
+            EXPECT_EQ(0, memcmp(symbol_storage_symbol(encoder_storage, event.m_index),
+                                symbol_storage_symbol(decoder_storage, event.m_index),
+                                symbol_size));
+        }
+        else
+        {
+            EXPECT_EQ(kslide_pipeline_symbol_popped, event.m_type);
+            EXPECT_EQ(popped, event.m_index);
+            ++popped;
+        }
+    }
+
+    producer.join();
+    kslide_delete_decoder_pipeline(pipeline);
+
+    EXPECT_EQ(symbols, popped);
+    for (uint64_t i = 0; i < symbols; ++i)
+    {
+        EXPECT_EQ(1U, decoded[i]);
+    }
+    EXPECT_EQ(symbols, kslide_decoder_stream_lower_bound(decoder));
+
+    kslide_delete_decoder(decoder);
+    kslide_delete_encoder(encoder);
+
+    symbol_storage_free(decoder_storage);
+    symbol_storage_free(encoder_storage);
+
+    kslide_delete_decoder_factory(decoder_factory);
+    kslide_delete_encoder_factory(encoder_factory);
+}
+
+TEST(test_kodo_slide_c, file_source)
+{
+    srand(time(0));
+
+    uint64_t symbol_size = 1000U;
+    uint64_t file_size = 100 * symbol_size + 123;
+    const char* path = "kodo_slide_c_file_source_test.bin";
+
+    std::vector<uint8_t> data(file_size);
+    randomize_buffer(data.data(), file_size);
+
+    FILE* file = fopen(path, "wb");
+    ASSERT_TRUE(file != nullptr);
+    ASSERT_EQ(file_size, fwrite(data.data(), 1, file_size, file));
+    fclose(file);
+
+    kslide_encoder_factory_t* encoder_factory = kslide_new_encoder_factory();
+    kslide_decoder_factory_t* decoder_factory = kslide_new_decoder_factory();
+    kslide_encoder_factory_set_symbol_size(encoder_factory, symbol_size);
+    kslide_decoder_factory_set_symbol_size(decoder_factory, symbol_size);
+
+    kslide_encoder_t* encoder = kslide_encoder_factory_build(encoder_factory);
+    kslide_decoder_t* decoder = kslide_decoder_factory_build(decoder_factory);
+
+    EXPECT_TRUE(kslide_new_file_source(encoder, "does_not_exist.bin") == nullptr);
+
+    kslide_file_source_t* source = kslide_new_file_source(encoder, path);
+    ASSERT_TRUE(source != nullptr);
+
+    EXPECT_EQ(file_size, kslide_file_source_file_size(source));
+    EXPECT_EQ(101U, kslide_file_source_symbols(source));
+
+    kslide_file_source_set_readahead(source, 8);
+    kslide_encoder_set_track_stream(encoder, 1);
+
+    std::vector<uint8_t> decoded(101 * symbol_size);
+    std::vector<uint8_t> symbol(symbol_size);
+    std::vector<uint8_t> coefficients(10);
+
+    for (uint64_t i = 0; i < 101; ++i)
+    {
+        kslide_decoder_push_front_symbol(decoder, &decoded[i * symbol_size]);
+    }
+
+    // Slide a window of 10 symbols over the file and send one coded symbol
+    // per source symbol
+    while (kslide_file_source_push_front_symbol(source))
+    {
+        if (kslide_encoder_stream_symbols(encoder) > 10)
+        {
+            kslide_file_source_pop_back_symbol(source);
+        }
+
+        kslide_encoder_write_source_symbol(
+            encoder, symbol.data(), kslide_encoder_stream_upper_bound(encoder) - 1);
+        kslide_decoder_read_source_symbol(
+            decoder, symbol.data(), kslide_encoder_stream_upper_bound(encoder) - 1);
+
+        uint64_t seed = rand();
+        kslide_encoder_set_seed(encoder, seed);
+        kslide_encoder_generate(encoder, coefficients.data());
+        kslide_encoder_write_symbol(encoder, symbol.data(), coefficients.data());
+
+        kslide_decoder_set_window(decoder,
+                                  kslide_encoder_window_lower_bound(encoder),
+                                  kslide_encoder_window_symbols(encoder));
+        kslide_decoder_read_symbol(decoder, symbol.data(), coefficients.data());
+    }
+
+    EXPECT_EQ(101U, kslide_encoder_stream_upper_bound(encoder));
+    EXPECT_EQ(0U, kslide_file_source_push_front_symbol(source));
+    EXPECT_EQ(101U, kslide_decoder_symbols_decoded(decoder));
+
+    // The last symbol is padded with zeros
+    EXPECT_EQ(0, memcmp(data.data(), decoded.data(), file_size));
+    for (uint64_t i = file_size; i < decoded.size(); ++i)
+    {
+        EXPECT_EQ(0U, decoded[i]);
+    }
+
+    kslide_delete_file_source(source);
+    remove(path);
+
+    kslide_delete_encoder(encoder);
+    kslide_delete_decoder(decoder);
+    kslide_delete_encoder_factory(encoder_factory);
+    kslide_delete_decoder_factory(decoder_factory);
+}
+
+TEST(test_kodo_slide_c, file_source_release)
+{
+    // A multiple of the page size, so every pop releases the pages of a
+    // whole symbol
+    uint64_t symbol_size = 65536U;
+    uint64_t file_size = 4 * symbol_size;
+    const char* path = "kodo_slide_c_file_source_release_test.bin";
+
+    std::vector<uint8_t> data(file_size);
+    randomize_buffer(data.data(), file_size);
+
+    FILE* file = fopen(path, "wb");
+    ASSERT_TRUE(file != nullptr);
+    ASSERT_EQ(file_size, fwrite(data.data(), 1, file_size, file));
+    fclose(file);
+
+    kslide_encoder_factory_t* encoder_factory = kslide_new_encoder_factory();
+    kslide_encoder_factory_set_symbol_size(encoder_factory, symbol_size);
+    kslide_encoder_t* encoder = kslide_encoder_factory_build(encoder_factory);
+
+    // The stream holds two symbols which are not part of the file
+    std::vector<uint8_t> outside(symbol_size);
+    kslide_encoder_push_front_symbol(encoder, outside.data());
+    kslide_encoder_push_front_symbol(encoder, outside.data());
+
+    kslide_file_source_t* source = kslide_new_file_source(encoder, path);
+    ASSERT_TRUE(source != nullptr);
+    while (kslide_file_source_push_front_symbol(source))
+    {
+    }
+
+    // Popping the symbols in front of the file releases nothing
+    EXPECT_EQ(0U, kslide_encoder_pop_back_symbol(encoder));
+    EXPECT_EQ(1U, kslide_file_source_pop_back_symbol(source));
+    EXPECT_EQ(0U, kslide_file_source_released_size(source));
+
+    // Pops through the encoder release the file like pops through the
+    // source
+    EXPECT_EQ(2U, kslide_encoder_pop_back_symbol(encoder));
+    EXPECT_EQ(symbol_size, kslide_file_source_released_size(source));
+    EXPECT_EQ(3U, kslide_file_source_pop_back_symbol(source));
+    EXPECT_EQ(2 * symbol_size, kslide_file_source_released_size(source));
+    EXPECT_EQ(4U, kslide_encoder_pop_back_symbol(encoder));
+    EXPECT_EQ(3 * symbol_size, kslide_file_source_released_size(source));
+
+    kslide_delete_file_source(source);
+    remove(path);
+
+    kslide_delete_encoder(encoder);
+    kslide_delete_encoder_factory(encoder_factory);
+}
+
+TEST(test_kodo_slide_c, file_sink)
+{
+    srand(time(0));
+
+    uint64_t symbol_size = 1000U;
+    uint64_t file_size = 50 * symbol_size + 321;
+    const char* path = "kodo_slide_c_file_sink_test.bin";
+
+    kslide_encoder_factory_t* encoder_factory = kslide_new_encoder_factory();
+    kslide_decoder_factory_t* decoder_factory = kslide_new_decoder_factory();
+    kslide_encoder_factory_set_symbol_size(encoder_factory, symbol_size);
+    kslide_decoder_factory_set_symbol_size(decoder_factory, symbol_size);
+
+    kslide_encoder_t* encoder = kslide_encoder_factory_build(encoder_factory);
+    kslide_decoder_t* decoder = kslide_decoder_factory_build(decoder_factory);
+
+    symbol_storage* encoder_storage = symbol_storage_alloc(51, symbol_size);
+    symbol_storage_randomize(encoder_storage);
+
+    kslide_file_sink_t* sink = kslide_new_file_sink(decoder, path, file_size);
+    ASSERT_TRUE(sink != nullptr);
+    EXPECT_EQ(51U, kslide_file_sink_symbols(sink));
+
+    kslide_encoder_set_track_stream(encoder, 1);
+    kslide_decoder_set_track_stream(decoder, 1);
+
+    std::vector<uint8_t> symbol(symbol_size);
+    std::vector<uint8_t> coefficients(10);
+
+    // Slide a window of up to 10 symbols over the file. The decoder only
+    // receives coded symbols and symbol 20 is deliberately left undecoded.
+    // The deadline of a symbol is its index.
+    for (uint64_t i = 0; i < 51; ++i)
+    {
+        kslide_encoder_push_front_symbol(
+            encoder, symbol_storage_symbol(encoder_storage, i));
+        EXPECT_EQ(1U, kslide_file_sink_push_front_symbol_with_deadline(
+            sink, i));
+
+        if (i == 20)
+        {
+            // Expire the stream before symbol 20 is decoded. The expired
+            // symbols go through the file sink as well.
+            uint64_t stream_symbols = kslide_encoder_stream_symbols(encoder);
+            while (kslide_encoder_stream_symbols(encoder) > 0)
+                kslide_encoder_pop_back_symbol(encoder);
+
+            EXPECT_EQ(stream_symbols, kslide_decoder_expire(decoder, i));
+            continue;
+        }
+
+        if (kslide_encoder_stream_symbols(encoder) > 10)
+        {
+            kslide_encoder_pop_back_symbol(encoder);
+            kslide_file_sink_pop_back_symbol(sink);
+        }
+
+        while (!kslide_decoder_is_symbol_decoded(decoder, i))
+        {
+            uint64_t seed = rand();
+            kslide_encoder_set_seed(encoder, seed);
+            kslide_encoder_generate(encoder, coefficients.data());
+            kslide_encoder_write_symbol(encoder, symbol.data(), coefficients.data());
+            kslide_decoder_read_symbol(decoder, symbol.data(), coefficients.data());
+        }
+    }
+
+    EXPECT_EQ(0U, kslide_file_sink_push_front_symbol(sink));
+
+    while (kslide_decoder_stream_symbols(decoder) > 0)
+    {
+        kslide_file_sink_pop_back_symbol(sink);
+    }
+
+    kslide_delete_file_sink(sink);
+
+    // Read back the file and compare it with the source symbols
+    std::vector<uint8_t> data(file_size + 1);
+    FILE* file = fopen(path, "rb");
+    ASSERT_TRUE(file != nullptr);
+    EXPECT_EQ(file_size, fread(data.data(), 1, data.size(), file));
+    fclose(file);
+    remove(path);
+
+    for (uint64_t i = 0; i < 51; ++i)
+    {
+        uint64_t size = std::min(symbol_size, file_size - i * symbol_size);
+        uint8_t* decoded = &data[i * symbol_size];
+
+        if (i == 20)
+        {
+            EXPECT_EQ(0U, accumulate_buffer(decoded, size));
+        }
+        else
+        {
+            EXPECT_EQ(0, memcmp(symbol_storage_symbol(encoder_storage, i),
+                                decoded, size));
+        }
+    }
+
+    symbol_storage_free(encoder_storage);
+    kslide_delete_encoder(encoder);
+    kslide_delete_decoder(decoder);
+    kslide_delete_encoder_factory(encoder_factory);
+    kslide_delete_decoder_factory(decoder_factory);
+}
+
+TEST(test_kodo_slide_c, file_sink_non_empty_stream)
+{
+    uint64_t symbol_size = 100U;
+    uint64_t file_size = 2 * symbol_size;
+    const char* path = "kodo_slide_c_file_sink_non_empty_test.bin";
+
+    kslide_decoder_factory_t* decoder_factory = kslide_new_decoder_factory();
+    kslide_decoder_factory_set_symbol_size(decoder_factory, symbol_size);
+    kslide_decoder_t* decoder = kslide_decoder_factory_build(decoder_factory);
+
+    // The stream holds a symbol which is not part of the file
+    std::vector<uint8_t> outside(symbol_size, 0xAB);
+    EXPECT_EQ(0U, kslide_decoder_push_front_symbol(decoder, outside.data()));
+
+    kslide_file_sink_t* sink = kslide_new_file_sink(decoder, path, file_size);
+    ASSERT_TRUE(sink != nullptr);
+    EXPECT_EQ(1U, kslide_file_sink_push_front_symbol(sink));
+    EXPECT_EQ(1U, kslide_file_sink_push_front_symbol(sink));
+
+    // Popping the symbol in front of the file leaves the file alone
+    EXPECT_EQ(0U, kslide_decoder_pop_back_symbol(decoder));
+    EXPECT_EQ(0xAB, outside[0]);
+
+    EXPECT_EQ(1U, kslide_decoder_pop_back_symbol(decoder));
+    EXPECT_EQ(2U, kslide_file_sink_pop_back_symbol(sink));
+    EXPECT_EQ(0U, kslide_decoder_stream_symbols(decoder));
+
+    kslide_delete_file_sink(sink);
+
+    // Nothing was decoded, so the file is zeroed
+    std::vector<uint8_t> data(file_size + 1);
+    FILE* file = fopen(path, "rb");
+    ASSERT_TRUE(file != nullptr);
+    EXPECT_EQ(file_size, fread(data.data(), 1, data.size(), file));
+    fclose(file);
+    remove(path);
+    EXPECT_EQ(0U, accumulate_buffer(data.data(), file_size));
+
+    kslide_delete_decoder(decoder);
+    kslide_delete_decoder_factory(decoder_factory);
+}
+
+TEST(test_kodo_slide_c, compress_coefficients)
+{
+    srand(time(0));
+
+    for (auto field : { kslide_binary, kslide_binary4, kslide_binary8,
+                        kslide_binary16 })
+    {
+        for (uint64_t symbols : { 1U, 7U, 64U, 1000U })
+        {
+            uint64_t bits = field == kslide_binary ? 1 :
+                            field == kslide_binary4 ? 4 :
+                            field == kslide_binary8 ? 8 : 16;
+            uint64_t size = (symbols * bits + 7) / 8;
+            uint64_t max_size =
+                kslide_coefficients_max_compressed_size(field, symbols);
+
+            std::vector<uint8_t> coefficients(size);
+            std::vector<uint8_t> data(max_size);
+            std::vector<uint8_t> output(size);
+
+            // Dense, sparse and clustered vectors
+            for (uint32_t density : { 100U, 5U, 0U })
+            {
+                std::fill(coefficients.begin(), coefficients.end(), 0);
+
+                if (density == 100U)
+                {
+                    for (uint64_t i = 0; i < size; ++i)
+                        coefficients[i] = rand();
+                }
+                else if (density > 0)
+                {
+                    // Every 20th byte is non-zero, so the size check below
+                    // does not depend on the random values
+                    for (uint64_t i = 0; i < size; i += 100 / density)
+                        coefficients[i] = 0xFF;
+                }
+                else
+                {
+                    // A single cluster of non-zero coefficients
+                    for (uint64_t i = size / 2; i < size / 2 + 2 && i < size; ++i)
+                        coefficients[i] = 0xFF;
+                }
+
+                // Padding bits are not preserved
+                uint64_t used_bits = symbols * bits;
+                if (used_bits % 8 != 0)
+                    coefficients[size - 1] &= (1U << (used_bits % 8)) - 1;
+
+                uint64_t compressed = kslide_compress_coefficients(
+                    field, symbols, coefficients.data(), data.data());
+                EXPECT_LE(compressed, max_size);
+
+                if (density == 5U && symbols == 1000U)
+                {
+                    EXPECT_LT(compressed, size / 2);
+                }
+
+                EXPECT_EQ(compressed, kslide_decompress_coefficients(
+                    field, symbols, data.data(), compressed, output.data()));
+                EXPECT_EQ(coefficients, output);
+
+                // Truncated data is rejected
+                EXPECT_EQ(0U, kslide_decompress_coefficients(
+                    field, symbols, data.data(), compressed - 1, output.data()));
+            }
+        }
+    }
+
+    // Decode with compressed coefficients through the decoder
+    uint64_t symbols = 100U;
+    uint64_t symbol_size = 100U;
+
+    kslide_decoder_factory_t* decoder_factory = kslide_new_decoder_factory();
+    kslide_encoder_factory_t* encoder_factory = kslide_new_encoder_factory();
+    kslide_decoder_factory_set_symbol_size(decoder_factory, symbol_size);
+    kslide_encoder_factory_set_symbol_size(encoder_factory, symbol_size);
+
+    kslide_decoder_t* decoder = kslide_decoder_factory_build(decoder_factory);
+    kslide_encoder_t* encoder = kslide_encoder_factory_build(encoder_factory);
+
+    symbol_storage* encoder_storage = symbol_storage_alloc(symbols, symbol_size);
+    symbol_storage* decoder_storage = symbol_storage_alloc(symbols, symbol_size);
+    symbol_storage_randomize(encoder_storage);
+
+    for (uint64_t i = 0; i < symbols; ++i)
+    {
+        kslide_encoder_push_front_symbol(
+            encoder, symbol_storage_symbol(encoder_storage, i));
+        kslide_decoder_push_front_symbol(
+            decoder, symbol_storage_symbol(decoder_storage, i));
+    }
+
+    std::vector<uint8_t> symbol(symbol_size);
+    std::vector<uint8_t> coefficients(symbols);
+    std::vector<uint8_t> data(
+        kslide_coefficients_max_compressed_size(kslide_binary8, symbols));
+
+    // Each coded symbol covers a sliding group of 4 symbols of the window
+    uint32_t iterations = 0;
+    while (kslide_decoder_symbols_decoded(decoder) < symbols &&
+           iterations < 1000U)
+    {
+        uint64_t offset = (iterations / 5) * 4 % symbols;
+
+        kslide_encoder_set_window(encoder, 0, symbols);
+        kslide_decoder_set_window(decoder, 0, symbols);
+
+        std::fill(coefficients.begin(), coefficients.end(), 0);
+        for (uint64_t i = offset; i < offset + 4 && i < symbols; ++i)
+            coefficients[i] = rand() % 255 + 1;
+
+        kslide_encoder_write_symbol(encoder, symbol.data(), coefficients.data());
+
+        uint64_t size = kslide_encoder_compress_coefficients(
+            encoder, coefficients.data(), data.data());
+        EXPECT_LT(size, 20U);
+
+        EXPECT_EQ(size, kslide_decoder_read_compressed_symbol(
+            decoder, symbol.data(), data.data(), size));
+        ++iterations;
+    }
+
+    EXPECT_EQ(symbols, kslide_decoder_symbols_decoded(decoder));
+    EXPECT_EQ(0, memcmp(encoder_storage->m_data, decoder_storage->m_data,
+                        symbols * symbol_size));
+
+    // Invalid data is rejected
+    data[0] = 0xFF;
+    EXPECT_EQ(0U, kslide_decoder_read_compressed_symbol(
+        decoder, symbol.data(), data.data(), data.size()));
+
+    kslide_delete_decoder(decoder);
+    kslide_delete_encoder(encoder);
+    symbol_storage_free(decoder_storage);
+    symbol_storage_free(encoder_storage);
+    kslide_delete_decoder_factory(decoder_factory);
+    kslide_delete_encoder_factory(encoder_factory);
+}
+
+TEST(test_kodo_slide_c, decoded_prefix)
+{
+    uint64_t symbols = 10U;
+    uint64_t symbol_size = 10U;
+
+    kslide_decoder_factory_t* factory = kslide_new_decoder_factory();
+    kslide_decoder_factory_set_symbol_size(factory, symbol_size);
+    kslide_decoder_t* decoder = kslide_decoder_factory_build(factory);
+
+    symbol_storage* storage = symbol_storage_alloc(symbols, symbol_size);
+    std::vector<uint8_t> symbol(symbol_size, 1);
+
+    EXPECT_EQ(0U, kslide_decoder_decoded_prefix_upper_bound(decoder));
+
+    for (uint64_t i = 0; i < symbols; ++i)
+    {
+        kslide_decoder_push_front_symbol(
+            decoder, symbol_storage_symbol(storage, i));
+    }
+
+    EXPECT_EQ(0U, kslide_decoder_decoded_prefix_upper_bound(decoder));
+
+    // Deliver the symbols out of order
+    kslide_decoder_read_source_symbol(decoder, symbol.data(), 1);
+    kslide_decoder_read_source_symbol(decoder, symbol.data(), 3);
+    EXPECT_EQ(0U, kslide_decoder_decoded_prefix_upper_bound(decoder));
+
+    kslide_decoder_read_source_symbol(decoder, symbol.data(), 0);
+    EXPECT_EQ(2U, kslide_decoder_decoded_prefix_upper_bound(decoder));
+
+    kslide_decoder_read_source_symbol(decoder, symbol.data(), 2);
+    EXPECT_EQ(4U, kslide_decoder_decoded_prefix_upper_bound(decoder));
+
+    // Release the prefix
+    while (kslide_decoder_stream_lower_bound(decoder) <
+           kslide_decoder_decoded_prefix_upper_bound(decoder))
+    {
+        kslide_decoder_pop_back_symbol(decoder);
+    }
+    EXPECT_EQ(4U, kslide_decoder_stream_lower_bound(decoder));
+    EXPECT_EQ(4U, kslide_decoder_decoded_prefix_upper_bound(decoder));
+
+    // Popping an undecoded symbol moves the prefix with the stream
+    kslide_decoder_read_source_symbol(decoder, symbol.data(), 5);
+    kslide_decoder_pop_back_symbol(decoder);
+    EXPECT_EQ(6U, kslide_decoder_decoded_prefix_upper_bound(decoder));
+
+    for (uint64_t i = 6; i < symbols; ++i)
+    {
+        kslide_decoder_read_source_symbol(decoder, symbol.data(), i);
+    }
+    EXPECT_EQ(symbols, kslide_decoder_decoded_prefix_upper_bound(decoder));
+
+    // The prefix restarts with the stream
+    kslide_decoder_factory_initialize(factory, decoder);
+    EXPECT_EQ(0U, kslide_decoder_decoded_prefix_upper_bound(decoder));
+
+    symbol_storage_free(storage);
+    kslide_delete_decoder(decoder);
+    kslide_delete_decoder_factory(factory);
+}
+
+TEST(test_kodo_slide_c, decoder_expire)
+{
+    uint64_t symbols = 10U;
+    uint64_t symbol_size = 10U;
+
+    kslide_decoder_factory_t* factory = kslide_new_decoder_factory();
+    kslide_decoder_factory_set_symbol_size(factory, symbol_size);
+    kslide_decoder_t* decoder = kslide_decoder_factory_build(factory);
+
+    symbol_storage* storage = symbol_storage_alloc(symbols, symbol_size);
+
+    // Symbol i must be played out at time 100 + 10 * i
+    for (uint64_t i = 0; i < symbols; ++i)
+    {
+        EXPECT_EQ(i, kslide_decoder_push_front_symbol_with_deadline(
+            decoder, symbol_storage_symbol(storage, i), 100 + 10 * i));
+    }
+
+    kslide_decoder_set_window(decoder, 0, symbols);
+
+    EXPECT_EQ(0U, kslide_decoder_expire(decoder, 0));
+    EXPECT_EQ(0U, kslide_decoder_expire(decoder, 99));
+    EXPECT_EQ(1U, kslide_decoder_expire(decoder, 100));
+    EXPECT_EQ(1U, kslide_decoder_stream_lower_bound(decoder));
+
+    EXPECT_EQ(3U, kslide_decoder_expire(decoder, 135));
+    EXPECT_EQ(4U, kslide_decoder_stream_lower_bound(decoder));
+    EXPECT_EQ(6U, kslide_decoder_stream_symbols(decoder));
+
+    // Pending reads which only involve expired symbols are dropped, the
+    // others are applied when the symbols they involve are popped
+    std::vector<uint8_t> symbol(symbol_size, 1);
+    std::vector<uint8_t> coefficients(symbols, 1);
+    kslide_decoder_set_read_budget(decoder, 1);
+
+    kslide_decoder_set_window(decoder, 6, 4);
+    kslide_decoder_read_symbol(decoder, symbol.data(), coefficients.data());
+    kslide_decoder_set_window(decoder, 4, 2);
+    kslide_decoder_read_symbol(decoder, symbol.data(), coefficients.data());
+    kslide_decoder_set_window(decoder, 4, 4);
+    kslide_decoder_read_symbol(decoder, symbol.data(), coefficients.data());
+    EXPECT_EQ(3U, kslide_decoder_pending_reads(decoder));
+
+    kslide_decoder_reset_work(decoder);
+    kslide_decoder_set_window(decoder, 6, 4);
+    EXPECT_EQ(2U, kslide_decoder_expire(decoder, 155));
+    EXPECT_EQ(1U, kslide_decoder_dropped_reads(decoder));
+    EXPECT_EQ(0U, kslide_decoder_pending_reads(decoder));
+    EXPECT_EQ(8U, kslide_decoder_work(decoder));
+    kslide_decoder_set_read_budget(decoder, 0);
+
+    // Symbols without a deadline never expire
+    kslide_decoder_push_front_symbol(decoder, symbol_storage_symbol(storage, 0));
+    EXPECT_EQ(4U, kslide_decoder_expire(decoder, UINT64_MAX - 1));
+    EXPECT_EQ(1U, kslide_decoder_stream_symbols(decoder));
+    EXPECT_EQ(10U, kslide_decoder_stream_lower_bound(decoder));
+
+    symbol_storage_free(storage);
+    kslide_delete_decoder(decoder);
+    kslide_delete_decoder_factory(factory);
+}
+
+TEST(test_kodo_slide_c, shared_scratch)
+{
+    srand(static_cast<uint32_t>(time(0)));
+
+    uint64_t symbols = 20U;
+    uint64_t symbol_size = 16U;
+    uint32_t decoders = 3U;
+
+    kslide_decoder_factory_t* decoder_factory = kslide_new_decoder_factory();
+    kslide_encoder_factory_t* encoder_factory = kslide_new_encoder_factory();
+    kslide_decoder_factory_set_symbol_size(decoder_factory, symbol_size);
+    kslide_encoder_factory_set_symbol_size(encoder_factory, symbol_size);
+
+    kslide_encoder_t* encoder = kslide_encoder_factory_build(encoder_factory);
+    symbol_storage* encoder_storage = symbol_storage_alloc(symbols, symbol_size);
+    symbol_storage_randomize(encoder_storage);
+
+    for (uint64_t i = 0; i < symbols; ++i)
+    {
+        kslide_encoder_push_front_symbol(
+            encoder, symbol_storage_symbol(encoder_storage, i));
+    }
+    kslide_encoder_set_window(encoder, 0, symbols);
+
+    kslide_scratch_t* scratch = kslide_new_scratch();
+    EXPECT_EQ(0U, kslide_scratch_size(scratch));
+
+    std::vector<kslide_decoder_t*> decoder(decoders);
+    std::vector<symbol_storage*> decoder_storage(decoders);
+    for (uint32_t d = 0; d < decoders; ++d)
+    {
+        decoder[d] = kslide_decoder_factory_build(decoder_factory);
+        decoder_storage[d] = symbol_storage_alloc(symbols, symbol_size);
+        kslide_decoder_set_scratch(decoder[d], scratch);
+
+        for (uint64_t i = 0; i < symbols; ++i)
+        {
+            kslide_decoder_push_front_symbol(
+                decoder[d], symbol_storage_symbol(decoder_storage[d], i));
+        }
+        kslide_decoder_set_window(decoder[d], 0, symbols);
+    }
+
+    std::vector<uint8_t> symbol(symbol_size);
+    std::vector<uint8_t> coefficients(
+        kslide_encoder_coefficient_vector_size(encoder));
+    std::vector<uint8_t> data(
+        kslide_coefficients_max_compressed_size(kslide_binary8, symbols));
+
+    // The decoders take turns, so the arena is reused between them
+    uint32_t iterations = 0;
+    while (kslide_decoder_symbols_decoded(decoder[decoders - 1]) < symbols &&
+           iterations < 1000U)
+    {
+        kslide_encoder_set_seed(encoder, rand());
+        kslide_encoder_generate(encoder, coefficients.data());
+        kslide_encoder_write_symbol(encoder, symbol.data(), coefficients.data());
+
+        uint64_t size = kslide_encoder_compress_coefficients(
+            encoder, coefficients.data(), data.data());
+
+        std::vector<uint8_t> coded = symbol;
+        for (uint32_t d = 0; d < decoders; ++d)
+        {
+            symbol = coded;
+            EXPECT_EQ(size, kslide_decoder_read_compressed_symbol(
+                decoder[d], symbol.data(), data.data(), size));
+        }
+        ++iterations;
+    }
+
+    EXPECT_EQ(coefficients.size(), kslide_scratch_size(scratch));
+
+    for (uint32_t d = 0; d < decoders; ++d)
+    {
+        EXPECT_EQ(symbols, kslide_decoder_symbols_decoded(decoder[d]));
+        EXPECT_EQ(0, memcmp(encoder_storage->m_data,
+                            decoder_storage[d]->m_data,
+                            symbols * symbol_size));
+
+        kslide_delete_decoder(decoder[d]);
+        symbol_storage_free(decoder_storage[d]);
+    }
+
+    kslide_delete_scratch(scratch);
+    kslide_delete_encoder(encoder);
+    symbol_storage_free(encoder_storage);
+    kslide_delete_decoder_factory(decoder_factory);
+    kslide_delete_encoder_factory(encoder_factory);
+}
+
+TEST(test_kodo_slide_c, reset)
+{
+    uint64_t symbols = 5U;
+    uint64_t symbol_size = 10U;
+
+    kslide_decoder_factory_t* decoder_factory = kslide_new_decoder_factory();
+    kslide_encoder_factory_t* encoder_factory = kslide_new_encoder_factory();
+    kslide_decoder_factory_set_field(decoder_factory, kslide_binary4);
+    kslide_encoder_factory_set_field(encoder_factory, kslide_binary4);
+    kslide_decoder_factory_set_symbol_size(decoder_factory, symbol_size);
+    kslide_encoder_factory_set_symbol_size(encoder_factory, symbol_size);
+
+    kslide_decoder_t* decoder = kslide_decoder_factory_build(decoder_factory);
+    kslide_encoder_t* encoder = kslide_encoder_factory_build(encoder_factory);
+
+    symbol_storage* encoder_storage = symbol_storage_alloc(symbols, symbol_size);
+    symbol_storage* decoder_storage = symbol_storage_alloc(symbols, symbol_size);
+    std::vector<uint8_t> symbol(symbol_size);
+    std::vector<uint8_t> coefficients(symbols);
+
+    // Run a few flows through the same encoder and decoder
+    for (uint32_t flow = 0; flow < 3; ++flow)
+    {
+        symbol_storage_randomize(encoder_storage);
+
+        for (uint64_t i = 0; i < symbols; ++i)
+        {
+            EXPECT_EQ(i, kslide_encoder_push_front_symbol(
+                encoder, symbol_storage_symbol(encoder_storage, i)));
+            EXPECT_EQ(i, kslide_decoder_push_front_symbol(
+                decoder, symbol_storage_symbol(decoder_storage, i)));
+        }
+
+        kslide_encoder_set_window(encoder, 0, symbols);
+        kslide_decoder_set_window(decoder, 0, symbols);
+
+        uint32_t iterations = 0;
+        while (kslide_decoder_symbols_decoded(decoder) < symbols &&
+               iterations < 1000U)
+        {
+            kslide_encoder_set_seed(encoder, iterations);
+            kslide_encoder_generate(encoder, coefficients.data());
+            kslide_encoder_write_symbol(
+                encoder, symbol.data(), coefficients.data());
+            kslide_decoder_read_symbol(
+                decoder, symbol.data(), coefficients.data());
+            ++iterations;
+        }
+
+        EXPECT_EQ(0, memcmp(encoder_storage->m_data, decoder_storage->m_data,
+                            symbols * symbol_size));
+
+        // Leave part of the stream behind before the reset
+        kslide_encoder_pop_back_symbol(encoder);
+        kslide_decoder_pop_back_symbol(decoder);
+
+        kslide_encoder_reset(encoder);
+        kslide_decoder_reset(decoder);
+
+        EXPECT_EQ(symbol_size, kslide_encoder_symbol_size(encoder));
+        EXPECT_EQ(symbol_size, kslide_decoder_symbol_size(decoder));
+        EXPECT_EQ(0U, kslide_encoder_stream_symbols(encoder));
+        EXPECT_EQ(0U, kslide_decoder_stream_symbols(decoder));
+        EXPECT_EQ(0U, kslide_encoder_stream_lower_bound(encoder));
+        EXPECT_EQ(0U, kslide_decoder_stream_lower_bound(decoder));
+        EXPECT_EQ(0U, kslide_decoder_rank(decoder));
+        EXPECT_EQ(0U, kslide_decoder_decoded_prefix_upper_bound(decoder));
+    }
+
+    kslide_delete_decoder(decoder);
+    kslide_delete_encoder(encoder);
+
+    // A reset coder generates the same coefficients as a new one, also with
+    // the counter based generator which keeps the seed in the wrapper
+    kslide_encoder_factory_set_generator(
+        encoder_factory, kslide_generator_counter);
+    kslide_decoder_factory_set_generator(
+        decoder_factory, kslide_generator_counter);
+
+    encoder = kslide_encoder_factory_build(encoder_factory);
+    decoder = kslide_decoder_factory_build(decoder_factory);
+    kslide_encoder_t* new_encoder =
+        kslide_encoder_factory_build(encoder_factory);
+    kslide_decoder_t* new_decoder =
+        kslide_decoder_factory_build(decoder_factory);
+
+    kslide_encoder_set_seed(encoder, 1234);
+    kslide_decoder_set_seed(decoder, 1234);
+    kslide_encoder_reset(encoder);
+    kslide_decoder_reset(decoder);
+
+    kslide_encoder_t* encoders[] = {encoder, new_encoder};
+    kslide_decoder_t* decoders[] = {decoder, new_decoder};
+    std::vector<uint8_t> expected(coefficients.size());
+    for (uint32_t i = 0; i < 2; ++i)
+    {
+        for (uint64_t j = 0; j < symbols; ++j)
+        {
+            kslide_encoder_push_front_symbol(
+                encoders[i], symbol_storage_symbol(encoder_storage, j));
+            kslide_decoder_push_front_symbol(
+                decoders[i], symbol_storage_symbol(decoder_storage, j));
+        }
+        kslide_encoder_set_window(encoders[i], 0, symbols);
+        kslide_decoder_set_window(decoders[i], 0, symbols);
+    }
+
+    kslide_encoder_generate(new_encoder, expected.data());
+    kslide_encoder_generate(encoder, coefficients.data());
+    EXPECT_EQ(expected, coefficients);
+    kslide_decoder_generate(decoder, coefficients.data());
+    EXPECT_EQ(expected, coefficients);
+    kslide_decoder_generate(new_decoder, coefficients.data());
+    EXPECT_EQ(expected, coefficients);
+
+    kslide_delete_decoder(new_decoder);
+    kslide_delete_encoder(new_encoder);
+    kslide_delete_decoder(decoder);
+    kslide_delete_encoder(encoder);
+    symbol_storage_free(decoder_storage);
+    symbol_storage_free(encoder_storage);
+    kslide_delete_decoder_factory(decoder_factory);
+    kslide_delete_encoder_factory(encoder_factory);
+}
+
+namespace
+{
+struct allocation_counter
+{
+    uint64_t m_allocations = 0;
+    uint64_t m_aligned_allocations = 0;
+    uint64_t m_frees = 0;
+};
+
+// Portable aligned allocation: the pointer returned by malloc is stored in
+// front of the aligned block
+void* aligned_malloc(uint64_t alignment, uint64_t size)
+{
+    uint8_t* ptr = (uint8_t*) malloc(size + alignment + sizeof(void*));
+    if (ptr == NULL)
+        return NULL;
+
+    uintptr_t aligned = ((uintptr_t) ptr + sizeof(void*) + alignment - 1) &
+                        ~(uintptr_t) (alignment - 1);
+    ((void**) aligned)[-1] = ptr;
+    return (void*) aligned;
+}
+
+void* counting_malloc(void* context, uint64_t size)
+{
+    ((allocation_counter*) context)->m_allocations++;
+    return aligned_malloc(16, size);
+}
+
+void* counting_aligned_alloc(void* context, uint64_t alignment, uint64_t size)
+{
+    ((allocation_counter*) context)->m_aligned_allocations++;
+    return aligned_malloc(alignment, size);
+}
+
+void counting_free(void* context, void* ptr)
+{
+    ((allocation_counter*) context)->m_frees++;
+    free(((void**) ptr)[-1]);
+}
+}
+
+TEST(test_kodo_slide_c, allocator)
+{
+    uint64_t symbols = 10U;
+    uint64_t symbol_size = 10U;
+
+    allocation_counter counter;
+    kslide_allocator allocator =
+    {
+        counting_malloc, counting_aligned_alloc, counting_free, &counter
+    };
+    kslide_set_allocator(&allocator);
+
+    kslide_decoder_factory_t* factory = kslide_new_decoder_factory();
+    kslide_decoder_factory_set_symbol_size(factory, symbol_size);
+    kslide_decoder_t* decoder = kslide_decoder_factory_build(factory);
+    kslide_scratch_t* scratch = kslide_new_scratch();
+    kslide_decoder_set_scratch(decoder, scratch);
+
+    symbol_storage* storage = symbol_storage_alloc(symbols, symbol_size);
+    for (uint64_t i = 0; i < symbols; ++i)
+    {
+        kslide_decoder_push_front_symbol(
+            decoder, symbol_storage_symbol(storage, i));
+    }
+    kslide_decoder_set_window(decoder, 0, symbols);
+
+    // The expanded coefficients are stored in the aligned scratch buffer
+    std::vector<uint8_t> symbol(symbol_size);
+    std::vector<uint8_t> data(
+        kslide_coefficients_max_compressed_size(kslide_binary8, symbols));
+    std::vector<uint8_t> coefficients(symbols, 0);
+    coefficients[0] = 1;
+    uint64_t size = kslide_compress_coefficients(
+        kslide_binary8, symbols, coefficients.data(), data.data());
+    kslide_decoder_read_compressed_symbol(
+        decoder, symbol.data(), data.data(), size);
+
+    EXPECT_LE(3U, counter.m_allocations);
+    EXPECT_EQ(1U, counter.m_aligned_allocations);
+
+    kslide_delete_decoder(decoder);
+    kslide_delete_scratch(scratch);
+    kslide_delete_decoder_factory(factory);
+    symbol_storage_free(storage);
+
+    EXPECT_EQ(counter.m_allocations + counter.m_aligned_allocations,
+              counter.m_frees);
+
+    kslide_set_allocator(NULL);
+}
+
+TEST(test_kodo_slide_c, reset_allocations)
+{
+    uint64_t symbols = 200U;
+    uint64_t symbol_size = 16U;
+    uint64_t window = 32U;
+
+    allocation_counter counter;
+    kslide_allocator allocator =
+    {
+        counting_malloc, counting_aligned_alloc, counting_free, &counter
+    };
+    kslide_set_allocator(&allocator);
+
+    kslide_encoder_factory_t* encoder_factory = kslide_new_encoder_factory();
+    kslide_decoder_factory_t* decoder_factory = kslide_new_decoder_factory();
+    kslide_encoder_factory_set_symbol_size(encoder_factory, symbol_size);
+    kslide_decoder_factory_set_symbol_size(decoder_factory, symbol_size);
+    kslide_encoder_t* encoder = kslide_encoder_factory_build(encoder_factory);
+    kslide_decoder_t* decoder = kslide_decoder_factory_build(decoder_factory);
+
+    kslide_encoder_set_track_stream(encoder, 1);
+    kslide_decoder_set_track_stream(decoder, 1);
+    kslide_encoder_set_accumulators(encoder, 2, 1);
+    kslide_decoder_set_read_budget(decoder, 2 * window);
+
+    // Offset by one byte so the unaligned symbols are tracked as well
+    std::vector<uint8_t> encoder_data(symbols * symbol_size + 1);
+    std::vector<uint8_t> decoder_data(symbols * symbol_size + 1);
+    std::vector<uint8_t> symbol(symbol_size);
+    std::vector<uint8_t> coefficients(window);
+
+    uint64_t allocations = 0;
+    for (uint32_t flow = 0; flow < 4; ++flow)
+    {
+        for (uint64_t i = 0; i < symbols; ++i)
+        {
+            kslide_encoder_push_front_symbol(
+                encoder, encoder_data.data() + 1 + i * symbol_size);
+            kslide_decoder_push_front_symbol(
+                decoder, decoder_data.data() + 1 + i * symbol_size);
+
+            if (kslide_encoder_stream_symbols(encoder) > window)
+            {
+                kslide_encoder_pop_back_symbol(encoder);
+                kslide_decoder_pop_back_symbol(decoder);
+            }
+
+            if (i % 4 != 0)
+            {
+                kslide_encoder_write_source_symbol(encoder, symbol.data(), i);
+                kslide_decoder_read_source_symbol(decoder, symbol.data(), i);
+            }
+
+            kslide_encoder_set_seed(encoder, i);
+            kslide_encoder_generate(encoder, coefficients.data());
+            kslide_encoder_write_symbol(
+                encoder, symbol.data(), coefficients.data());
+            kslide_decoder_read_symbol(
+                decoder, symbol.data(), coefficients.data());
+        }
+
+        while (kslide_encoder_stream_symbols(encoder) > 0)
+        {
+            kslide_encoder_pop_back_symbol(encoder);
+            kslide_decoder_pop_back_symbol(decoder);
+        }
+
+        kslide_encoder_reset(encoder);
+        kslide_decoder_reset(decoder);
+
+        // Only the first flow allocates
+        uint64_t total = counter.m_allocations + counter.m_aligned_allocations;
+        if (flow == 0)
+            EXPECT_LT(0U, total);
+        else
+            EXPECT_EQ(allocations, total);
+        allocations = total;
+    }
+
+    kslide_delete_decoder(decoder);
+    kslide_delete_encoder(encoder);
+    kslide_delete_decoder_factory(decoder_factory);
+    kslide_delete_encoder_factory(encoder_factory);
+
+    EXPECT_EQ(counter.m_allocations + counter.m_aligned_allocations,
+              counter.m_frees);
+
+    kslide_set_allocator(NULL);
+}
+
+TEST(test_kodo_slide_c, encoders_write_symbols)
+{
+    uint64_t symbols = 8U;
+    uint64_t symbol_size = 16U;
+    uint32_t flows = 4U;
+
+    kslide_encoder_factory_t* factory = kslide_new_encoder_factory();
+    kslide_encoder_factory_set_symbol_size(factory, symbol_size);
+
+    std::vector<kslide_encoder_t*> encoders(flows);
+    std::vector<symbol_storage*> storage(flows);
+    std::vector<std::vector<uint8_t>> coded(
+        flows, std::vector<uint8_t>(symbol_size));
+    std::vector<uint8_t*> coded_symbols(flows);
+
+    for (uint32_t f = 0; f < flows; ++f)
+    {
+        encoders[f] = kslide_encoder_factory_build(factory);
+        storage[f] = symbol_storage_alloc(symbols, symbol_size);
+        symbol_storage_randomize(storage[f]);
+        coded_symbols[f] = coded[f].data();
+
+        for (uint64_t i = 0; i < symbols; ++i)
+        {
+            kslide_encoder_push_front_symbol(
+                encoders[f], symbol_storage_symbol(storage[f], i));
+        }
+
+        // Same window geometry at different stream positions
+        kslide_encoder_set_window(encoders[f], f % 2, symbols - 1);
+    }
+
+    std::vector<uint8_t> coefficients(
+        kslide_encoder_coefficient_vector_size(encoders[0]));
+    std::vector<uint8_t> expected(symbol_size);
+
+    kslide_encoders_write_seeded_symbols(
+        encoders.data(), flows, coded_symbols.data(), 42U);
+
+    for (uint32_t f = 0; f < flows; ++f)
+    {
+        kslide_encoder_set_seed(encoders[f], 42U);
+        kslide_encoder_generate(encoders[f], coefficients.data());
+        kslide_encoder_write_symbol(
+            encoders[f], expected.data(), coefficients.data());
+        EXPECT_EQ(expected, coded[f]);
+    }
+
+    randomize_buffer(coefficients.data(), coefficients.size());
+    kslide_encoders_write_symbols(
+        encoders.data(), flows, coded_symbols.data(), coefficients.data());
+
+    for (uint32_t f = 0; f < flows; ++f)
+    {
+        kslide_encoder_write_symbol(
+            encoders[f], expected.data(), coefficients.data());
+        EXPECT_EQ(expected, coded[f]);
+
+        kslide_delete_encoder(encoders[f]);
+        symbol_storage_free(storage[f]);
+    }
+
+    kslide_delete_encoder_factory(factory);
+}
+
+TEST(test_kodo_slide_c, encoder_accumulators)
+{
+    srand(static_cast<uint32_t>(time(0)));
+
+    uint64_t symbol_size = 32U;
+    uint64_t accumulators = 3U;
+
+    std::vector<int32_t> fields = {
+        kslide_binary, kslide_binary4, kslide_binary8, kslide_binary16};
+
+    for (int32_t field : fields)
+    {
+        kslide_encoder_factory_t* factory = kslide_new_encoder_factory();
+        kslide_encoder_factory_set_field(factory, field);
+        kslide_encoder_factory_set_symbol_size(factory, symbol_size);
+        kslide_encoder_t* encoder = kslide_encoder_factory_build(factory);
+        kslide_encoder_set_track_stream(encoder, 1);
+
+        symbol_storage* storage = symbol_storage_alloc(20U, symbol_size);
+        symbol_storage_randomize(storage);
+
+        // Symbols pushed before and after the accumulators are enabled
+        for (uint64_t i = 0; i < 5; ++i)
+        {
+            kslide_encoder_push_front_symbol(
+                encoder, symbol_storage_symbol(storage, i));
+        }
+
+        kslide_encoder_set_accumulators(encoder, accumulators, rand());
+        EXPECT_EQ(accumulators, kslide_encoder_accumulators(encoder));
+
+        std::vector<uint8_t> symbol(symbol_size);
+        std::vector<uint8_t> expected(symbol_size);
+
+        for (uint64_t i = 5; i < 20; ++i)
+        {
+            kslide_encoder_push_front_symbol(
+                encoder, symbol_storage_symbol(storage, i));
+
+            if (i % 3 == 0)
+                kslide_encoder_pop_back_symbol(encoder);
+
+            std::vector<uint8_t> coefficients(
+                kslide_encoder_coefficient_vector_size(encoder));
+
+            for (uint64_t a = 0; a < accumulators; ++a)
+            {
+                kslide_encoder_write_accumulated_symbol(
+                    encoder, a, symbol.data(), coefficients.data());
+                kslide_encoder_write_symbol(
+                    encoder, expected.data(), coefficients.data());
+                EXPECT_EQ(expected, symbol);
+            }
+        }
+
+        // The stream is empty again when all symbols are popped
+        while (kslide_encoder_stream_symbols(encoder) > 0)
+            kslide_encoder_pop_back_symbol(encoder);
+
+        std::vector<uint8_t> zero(symbol_size, 0);
+        kslide_encoder_write_accumulated_symbol(
+            encoder, 0, symbol.data(), zero.data());
+        EXPECT_EQ(zero, symbol);
+
+        symbol_storage_free(storage);
+        kslide_delete_encoder(encoder);
+        kslide_delete_encoder_factory(factory);
+    }
+}
+
+TEST(test_kodo_slide_c, cauchy_coefficients)
+{
+    srand(static_cast<uint32_t>(time(0)));
+
+    uint64_t symbol_size = 16U;
+    uint64_t repairs = 4U;
+
+    EXPECT_EQ(0U, kslide_cauchy_max_symbols(kslide_binary, repairs));
+    EXPECT_EQ(12U, kslide_cauchy_max_symbols(kslide_binary4, repairs));
+    EXPECT_EQ(252U, kslide_cauchy_max_symbols(kslide_binary8, repairs));
+    EXPECT_EQ(65532U, kslide_cauchy_max_symbols(kslide_binary16, repairs));
+
+    std::vector<int32_t> fields = {
+        kslide_binary4, kslide_binary8, kslide_binary16};
+
+    for (int32_t field : fields)
+    {
+        uint64_t symbols = std::min<uint64_t>(
+            20U, kslide_cauchy_max_symbols(field, repairs));
+
+        kslide_encoder_factory_t* encoder_factory = kslide_new_encoder_factory();
+        kslide_decoder_factory_t* decoder_factory = kslide_new_decoder_factory();
+        kslide_encoder_factory_set_field(encoder_factory, field);
+        kslide_decoder_factory_set_field(decoder_factory, field);
+        kslide_encoder_factory_set_symbol_size(encoder_factory, symbol_size);
+        kslide_decoder_factory_set_symbol_size(decoder_factory, symbol_size);
+
+        symbol_storage* encoder_storage =
+            symbol_storage_alloc(symbols, symbol_size);
+        symbol_storage_randomize(encoder_storage);
+
+        kslide_encoder_t* encoder =
+            kslide_encoder_factory_build(encoder_factory);
+        for (uint64_t i = 0; i < symbols; ++i)
+        {
+            kslide_encoder_push_front_symbol(
+                encoder, symbol_storage_symbol(encoder_storage, i));
+        }
+        kslide_encoder_set_window(encoder, 0, symbols);
+
+        std::vector<uint8_t> symbol(symbol_size);
+        std::vector<uint8_t> coefficients(
+            kslide_encoder_coefficient_vector_size(encoder));
+        std::vector<uint8_t> decoder_coefficients(coefficients.size());
+
+        // Any `lost` repair symbols recover any `lost` source symbols
+        for (uint32_t trial = 0; trial < 20; ++trial)
+        {
+            uint64_t lost = 1 + rand() % repairs;
+
+            kslide_decoder_t* decoder =
+                kslide_decoder_factory_build(decoder_factory);
+            symbol_storage* decoder_storage =
+                symbol_storage_alloc(symbols, symbol_size);
+
+            for (uint64_t i = 0; i < symbols; ++i)
+            {
+                kslide_decoder_push_front_symbol(
+                    decoder, symbol_storage_symbol(decoder_storage, i));
+            }
+            kslide_decoder_set_window(decoder, 0, symbols);
+
+            std::vector<uint64_t> indices(symbols);
+            for (uint64_t i = 0; i < symbols; ++i)
+                indices[i] = i;
+            for (uint64_t i = symbols - 1; i > 0; --i)
+                std::swap(indices[i], indices[rand() % (i + 1)]);
+
+            for (uint64_t i = lost; i < symbols; ++i)
+            {
+                kslide_encoder_write_source_symbol(
+                    encoder, symbol.data(), indices[i]);
+                kslide_decoder_read_source_symbol(
+                    decoder, symbol.data(), indices[i]);
+            }
+
+            uint64_t first_repair = rand() % (repairs - lost + 1);
+            for (uint64_t r = first_repair; r < first_repair + lost; ++r)
+            {
+                kslide_encoder_generate_cauchy(
+                    encoder, r, coefficients.data());
+                kslide_encoder_write_symbol(
+                    encoder, symbol.data(), coefficients.data());
+
+                kslide_decoder_generate_cauchy(
+                    decoder, r, decoder_coefficients.data());
+                EXPECT_EQ(coefficients, decoder_coefficients);
+                kslide_decoder_read_symbol(
+                    decoder, symbol.data(), decoder_coefficients.data());
+            }
+
+            EXPECT_EQ(symbols, kslide_decoder_symbols_decoded(decoder));
+            EXPECT_EQ(0, memcmp(encoder_storage->m_data,
+                                decoder_storage->m_data,
+                                symbols * symbol_size));
+
+            symbol_storage_free(decoder_storage);
+            kslide_delete_decoder(decoder);
+        }
+
+        symbol_storage_free(encoder_storage);
+        kslide_delete_encoder(encoder);
+        kslide_delete_encoder_factory(encoder_factory);
+        kslide_delete_decoder_factory(decoder_factory);
+    }
+}
+
+TEST(test_kodo_slide_c, cauchy_max_window)
+{
+    std::vector<int32_t> fields = {
+        kslide_binary4, kslide_binary8, kslide_binary16};
+    std::vector<uint64_t> repairs = {1U, 2U, 4U};
+
+    for (int32_t field : fields)
+    {
+        kslide_encoder_factory_t* factory = kslide_new_encoder_factory();
+        kslide_encoder_factory_set_field(factory, field);
+        kslide_encoder_factory_set_symbol_size(factory, 4U);
+        uint32_t bits = field == kslide_binary4 ? 4 :
+                        field == kslide_binary8 ? 8 : 16;
+
+        for (uint64_t count : repairs)
+        {
+            // The largest window with count repair symbols
+            uint64_t symbols = kslide_cauchy_max_symbols(field, count);
+            kslide_encoder_t* encoder = kslide_encoder_factory_build(factory);
+
+            std::vector<uint8_t> data(4U);
+            for (uint64_t i = 0; i < symbols; ++i)
+                kslide_encoder_push_front_symbol(encoder, data.data());
+            kslide_encoder_set_window(encoder, 0, symbols);
+
+            std::vector<uint8_t> coefficients(
+                kslide_encoder_coefficient_vector_size(encoder));
+
+            for (uint64_t r = 0; r < count; ++r)
+            {
+                kslide_encoder_generate_cauchy(
+                    encoder, r, coefficients.data());
+
+                uint64_t zeros = 0;
+                for (uint64_t j = 0; j < symbols; ++j)
+                {
+                    uint32_t value =
+                        bits == 4 ? (coefficients[j / 2] >> (4 * (j % 2))) & 0xF :
+                        bits == 8 ? coefficients[j] :
+                        coefficients[2 * j] | (coefficients[2 * j + 1] << 8);
+                    zeros += value == 0;
+                }
+                EXPECT_EQ(0U, zeros);
+            }
+
+            kslide_delete_encoder(encoder);
+        }
+
+        kslide_delete_encoder_factory(factory);
+    }
+}
+
+TEST(test_kodo_slide_c, feedback)
+{
+    uint64_t symbols = 20U;
+    uint64_t symbol_size = 10U;
+
+    kslide_encoder_factory_t* encoder_factory = kslide_new_encoder_factory();
+    kslide_decoder_factory_t* decoder_factory = kslide_new_decoder_factory();
+    kslide_encoder_factory_set_symbol_size(encoder_factory, symbol_size);
+    kslide_decoder_factory_set_symbol_size(decoder_factory, symbol_size);
+    kslide_encoder_t* encoder = kslide_encoder_factory_build(encoder_factory);
+    kslide_decoder_t* decoder = kslide_decoder_factory_build(decoder_factory);
+
+    symbol_storage* encoder_storage = symbol_storage_alloc(symbols, symbol_size);
+    symbol_storage* decoder_storage = symbol_storage_alloc(symbols, symbol_size);
+    symbol_storage_randomize(encoder_storage);
+
+    for (uint64_t i = 0; i < symbols; ++i)
+    {
+        kslide_encoder_push_front_symbol(
+            encoder, symbol_storage_symbol(encoder_storage, i));
+        kslide_decoder_push_front_symbol(
+            decoder, symbol_storage_symbol(decoder_storage, i));
+    }
+    kslide_encoder_set_window(encoder, 0, symbols);
+
+    // Symbol 6 and 9 are lost
+    std::vector<uint8_t> symbol(symbol_size);
+    for (uint64_t i = 0; i < 12; ++i)
+    {
+        if (i == 6 || i == 9)
+            continue;
+        kslide_encoder_write_source_symbol(encoder, symbol.data(), i);
+        kslide_decoder_read_source_symbol(decoder, symbol.data(), i);
+    }
+
+    std::vector<uint8_t> feedback(kslide_decoder_feedback_max_size(decoder));
+    uint64_t size = kslide_decoder_write_feedback(decoder, feedback.data());
+    EXPECT_EQ(3U + 1U + 2U, size);
+
+    EXPECT_EQ(size, kslide_encoder_read_feedback(
+        encoder, feedback.data(), size));
+
+    EXPECT_EQ(6U, kslide_encoder_stream_lower_bound(encoder));
+    EXPECT_EQ(14U, kslide_encoder_stream_symbols(encoder));
+    EXPECT_EQ(6U, kslide_encoder_window_lower_bound(encoder));
+    EXPECT_EQ(14U, kslide_encoder_window_symbols(encoder));
+    EXPECT_EQ(10U, kslide_encoder_feedback_symbols_missing(encoder));
+
+    EXPECT_EQ(1U, kslide_encoder_feedback_is_symbol_decoded(encoder, 5));
+    EXPECT_EQ(0U, kslide_encoder_feedback_is_symbol_decoded(encoder, 6));
+    EXPECT_EQ(1U, kslide_encoder_feedback_is_symbol_decoded(encoder, 7));
+    EXPECT_EQ(0U, kslide_encoder_feedback_is_symbol_decoded(encoder, 9));
+    EXPECT_EQ(1U, kslide_encoder_feedback_is_symbol_decoded(encoder, 11));
+    EXPECT_EQ(0U, kslide_encoder_feedback_is_symbol_decoded(encoder, 12));
+
+    // Truncated feedback is rejected
+    EXPECT_EQ(0U, kslide_encoder_read_feedback(
+        encoder, feedback.data(), size - 1));
+
+    symbol_storage_free(decoder_storage);
+    symbol_storage_free(encoder_storage);
+    kslide_delete_decoder(decoder);
+    kslide_delete_encoder(encoder);
+    kslide_delete_decoder_factory(decoder_factory);
+    kslide_delete_encoder_factory(encoder_factory);
+}
+
+TEST(test_kodo_slide_c, feedback_sparse_losses)
+{
+    uint64_t symbols = 1000U;
+    uint64_t symbol_size = 4U;
+
+    kslide_encoder_factory_t* encoder_factory = kslide_new_encoder_factory();
+    kslide_decoder_factory_t* decoder_factory = kslide_new_decoder_factory();
+    kslide_encoder_factory_set_symbol_size(encoder_factory, symbol_size);
+    kslide_decoder_factory_set_symbol_size(decoder_factory, symbol_size);
+    kslide_encoder_t* encoder = kslide_encoder_factory_build(encoder_factory);
+    kslide_decoder_t* decoder = kslide_decoder_factory_build(decoder_factory);
+
+    symbol_storage* encoder_storage = symbol_storage_alloc(symbols, symbol_size);
+    symbol_storage* decoder_storage = symbol_storage_alloc(symbols, symbol_size);
+
+    for (uint64_t i = 0; i < symbols; ++i)
+    {
+        kslide_encoder_push_front_symbol(
+            encoder, symbol_storage_symbol(encoder_storage, i));
+        kslide_decoder_push_front_symbol(
+            decoder, symbol_storage_symbol(decoder_storage, i));
+    }
+
+    // Every 100th symbol is lost, so the tail after the prefix is long but
+    // has few losses
+    std::vector<uint8_t> symbol(symbol_size);
+    for (uint64_t i = 0; i < symbols; ++i)
+    {
+        if (i % 100 == 10)
+            continue;
+        kslide_decoder_read_source_symbol(decoder, symbol.data(), i);
+    }
+
+    std::vector<uint8_t> feedback(kslide_decoder_feedback_max_size(decoder));
+    uint64_t size = kslide_decoder_write_feedback(decoder, feedback.data());
+
+    // The raw bitmap alone would take 124 bytes
+    EXPECT_LT(size, 40U);
+
+    EXPECT_EQ(size, kslide_encoder_read_feedback(
+        encoder, feedback.data(), size));
+    EXPECT_EQ(10U, kslide_encoder_stream_lower_bound(encoder));
+    EXPECT_EQ(10U, kslide_encoder_feedback_symbols_missing(encoder));
+
+    for (uint64_t i = 10; i < symbols; ++i)
+    {
+        EXPECT_EQ(i % 100 == 10 ? 0U : 1U,
+                  kslide_encoder_feedback_is_symbol_decoded(encoder, i));
+    }
+
+    symbol_storage_free(decoder_storage);
+    symbol_storage_free(encoder_storage);
+    kslide_delete_decoder(decoder);
+    kslide_delete_encoder(encoder);
+    kslide_delete_decoder_factory(decoder_factory);
+    kslide_delete_encoder_factory(encoder_factory);
+}
+
+TEST(test_kodo_slide_c, trace)
+{
+    uint64_t symbols = 4U;
+    uint64_t symbol_size = 10U;
+    const char* path = "kodo_slide_c_trace_test.bin";
+
+    kslide_decoder_factory_t* factory = kslide_new_decoder_factory();
+    kslide_decoder_factory_set_symbol_size(factory, symbol_size);
+    kslide_decoder_t* decoder = kslide_decoder_factory_build(factory);
+
+    symbol_storage* storage = symbol_storage_alloc(symbols, symbol_size);
+    std::vector<uint8_t> symbol(symbol_size, 1);
+
+    // Nothing is recorded while the trace is disabled
+    kslide_decoder_push_front_symbol(decoder, symbol_storage_symbol(storage, 0));
+    EXPECT_EQ(0U, kslide_decoder_trace_events(decoder));
+
+    kslide_decoder_set_trace(decoder, 5);
+
+    for (uint64_t i = 1; i < symbols; ++i)
+    {
+        kslide_decoder_push_front_symbol(
+            decoder, symbol_storage_symbol(storage, i));
+    }
+    kslide_decoder_set_window(decoder, 0, symbols);
+    kslide_decoder_read_source_symbol(decoder, symbol.data(), 0);
+    kslide_decoder_read_source_symbol(decoder, symbol.data(), 0);
+    kslide_decoder_pop_back_symbol(decoder);
+
+    // The ring keeps the 5 most recent of the 7 events
+    ASSERT_EQ(5U, kslide_decoder_trace_events(decoder));
+    std::vector<kslide_trace_event> events(5);
+    kslide_decoder_copy_trace(decoder, events.data());
+
+    EXPECT_EQ(kslide_trace_push_front_symbol, events[0].m_type);
+    EXPECT_EQ(3U, events[0].m_index);
+    EXPECT_EQ(4U, events[0].m_symbols);
+
+    EXPECT_EQ(kslide_trace_set_window, events[1].m_type);
+    EXPECT_EQ(0U, events[1].m_index);
+    EXPECT_EQ(4U, events[1].m_symbols);
+
+    EXPECT_EQ(kslide_trace_source_symbol, events[2].m_type);
+    EXPECT_EQ(1U, events[2].m_rank);
+    EXPECT_EQ(1U, events[2].m_value);
+    EXPECT_EQ(1U, events[2].m_innovative);
+
+    EXPECT_EQ(kslide_trace_source_symbol, events[3].m_type);
+    EXPECT_EQ(0U, events[3].m_innovative);
+
+    EXPECT_EQ(kslide_trace_pop_back_symbol, events[4].m_type);
+    EXPECT_EQ(0U, events[4].m_index);
+    EXPECT_EQ(3U, events[4].m_symbols);
+
+    for (uint32_t i = 1; i < 5; ++i)
+        EXPECT_LE(events[i - 1].m_time, events[i].m_time);
+
+    ASSERT_EQ(1U, kslide_decoder_dump_trace(decoder, path));
+
+    FILE* file = fopen(path, "rb");
+    ASSERT_TRUE(file != NULL);
+    kslide_trace_header header;
+    ASSERT_EQ(1U, fread(&header, sizeof(header), 1, file));
+    EXPECT_EQ((uint32_t) kslide_trace_magic, header.m_magic);
+    EXPECT_EQ((uint32_t) kslide_trace_version, header.m_version);
+    EXPECT_EQ(5U, header.m_events);
+
+    kslide_trace_event last;
+    fseek(file, 4 * sizeof(kslide_trace_event), SEEK_CUR);
+    ASSERT_EQ(1U, fread(&last, sizeof(last), 1, file));
+    EXPECT_EQ(0, memcmp(&events[4], &last, sizeof(last)));
+    fclose(file);
+    remove(path);
+
+    kslide_decoder_set_trace(decoder, 0);
+    EXPECT_EQ(0U, kslide_decoder_trace_events(decoder));
+
+    symbol_storage_free(storage);
+    kslide_delete_decoder(decoder);
+    kslide_delete_decoder_factory(factory);
+}
+
+TEST(test_kodo_slide_c, decoder_read_budget)
+{
+    uint64_t symbols = 10U;
+    uint64_t symbol_size = 16U;
+
+    kslide_encoder_factory_t* encoder_factory = kslide_new_encoder_factory();
+    kslide_decoder_factory_t* decoder_factory = kslide_new_decoder_factory();
+    kslide_encoder_factory_set_symbol_size(encoder_factory, symbol_size);
+    kslide_decoder_factory_set_symbol_size(decoder_factory, symbol_size);
+    kslide_encoder_t* encoder = kslide_encoder_factory_build(encoder_factory);
+    kslide_decoder_t* decoder = kslide_decoder_factory_build(decoder_factory);
+
+    symbol_storage* encoder_storage = symbol_storage_alloc(symbols, symbol_size);
+    symbol_storage* decoder_storage = symbol_storage_alloc(symbols, symbol_size);
+    symbol_storage_randomize(encoder_storage);
+
+    for (uint64_t i = 0; i < symbols; ++i)
+    {
+        kslide_encoder_push_front_symbol(
+            encoder, symbol_storage_symbol(encoder_storage, i));
+        kslide_decoder_push_front_symbol(
+            decoder, symbol_storage_symbol(decoder_storage, i));
+    }
+    kslide_encoder_set_window(encoder, 0, symbols);
+    kslide_decoder_set_window(decoder, 0, symbols);
+
+    // Two source symbols and one coded symbol fit in each read
+    kslide_decoder_set_read_budget(decoder, symbols + 2);
+    EXPECT_EQ(symbols + 2, kslide_decoder_read_budget(decoder));
+
+    std::vector<uint8_t> symbol(symbol_size);
+    std::vector<uint8_t> coefficients(
+        kslide_encoder_coefficient_vector_size(encoder));
+
+    for (uint64_t i = 0; i < 4; ++i)
+    {
+        kslide_encoder_write_source_symbol(encoder, symbol.data(), i);
+        kslide_decoder_read_source_symbol(decoder, symbol.data(), i);
+    }
+    EXPECT_EQ(0U, kslide_decoder_pending_reads(decoder));
+    EXPECT_EQ(4U, kslide_decoder_rank(decoder));
+
+    // The budget is too small for the coded symbols read in a burst
+    kslide_decoder_set_read_budget(decoder, symbols - 1);
+    for (uint32_t i = 0; i < symbols; ++i)
+    {
+        kslide_encoder_set_seed(encoder, i);
+        kslide_encoder_generate(encoder, coefficients.data());
+        kslide_encoder_write_symbol(encoder, symbol.data(), coefficients.data());
+        kslide_decoder_read_symbol(decoder, symbol.data(), coefficients.data());
+    }
+    EXPECT_EQ(symbols, kslide_decoder_pending_reads(decoder));
+    EXPECT_EQ(4U, kslide_decoder_rank(decoder));
+
+    // The decoder window can move while the reads are pending
+    kslide_decoder_set_window(decoder, 5, 1);
+
+    // Each step applies the oldest read and whatever else fits
+    EXPECT_EQ(symbols - 1, kslide_decoder_step(decoder, 1));
+    EXPECT_EQ(symbols - 3, kslide_decoder_step(decoder, 2 * symbols));
+    EXPECT_EQ(5U, kslide_decoder_window_lower_bound(decoder));
+    EXPECT_EQ(1U, kslide_decoder_window_symbols(decoder));
+
+    // Popping applies the reads which involve the popped symbol
+    kslide_decoder_pop_back_symbol(decoder);
+    EXPECT_EQ(0U, kslide_decoder_pending_reads(decoder));
+    EXPECT_EQ(0, memcmp(encoder_storage->m_data + symbol_size,
+                        decoder_storage->m_data + symbol_size,
+                        (symbols - 1) * symbol_size));
+
+    symbol_storage_free(decoder_storage);
+    symbol_storage_free(encoder_storage);
+    kslide_delete_decoder(decoder);
+    kslide_delete_encoder(encoder);
+    kslide_delete_decoder_factory(decoder_factory);
+    kslide_delete_encoder_factory(encoder_factory);
+}
+
+TEST(test_kodo_slide_c, aligned_fast_path)
+{
+    uint64_t symbols = 4U;
+    uint64_t symbol_size = 100U;
+    uint64_t alignment = kslide_preferred_alignment();
+    EXPECT_EQ(0U, alignment & (alignment - 1));
+
+    kslide_encoder_factory_t* encoder_factory = kslide_new_encoder_factory();
+    kslide_decoder_factory_t* decoder_factory = kslide_new_decoder_factory();
+    kslide_encoder_factory_set_symbol_size(encoder_factory, symbol_size);
+    kslide_decoder_factory_set_symbol_size(decoder_factory, symbol_size);
+    kslide_encoder_t* encoder = kslide_encoder_factory_build(encoder_factory);
+    kslide_decoder_t* decoder = kslide_decoder_factory_build(decoder_factory);
+
+    // Symbols with the preferred alignment, padded to a multiple of it
+    uint64_t stride = (symbol_size + alignment - 1) / alignment * alignment;
+    std::vector<uint8_t> memory((2 * symbols + 2) * stride + alignment);
+    uint8_t* base = memory.data() +
+        (alignment - (uintptr_t) memory.data() % alignment) % alignment;
+    uint8_t* encoder_symbols = base;
+    uint8_t* decoder_symbols = base + symbols * stride;
+
+    // Coded symbols are written to and read from unaligned buffers
+    uint8_t* unaligned = base + 2 * symbols * stride + 1;
+
+    randomize_buffer(encoder_symbols, symbols * stride);
+    memset(decoder_symbols, 0, symbols * stride);
+
+    EXPECT_EQ(1U, kslide_encoder_is_aligned(encoder));
+    EXPECT_EQ(1U, kslide_decoder_is_aligned(decoder));
+
+    // The aligned copy is opt-in
+    EXPECT_EQ(0U, kslide_encoder_aligned_copy(encoder));
+    EXPECT_EQ(0U, kslide_decoder_aligned_copy(decoder));
+    kslide_encoder_set_aligned_copy(encoder, 1);
+    kslide_decoder_set_aligned_copy(decoder, 1);
+    EXPECT_EQ(1U, kslide_encoder_aligned_copy(encoder));
+    EXPECT_EQ(1U, kslide_decoder_aligned_copy(decoder));
+
+    for (uint64_t i = 0; i < symbols; ++i)
+    {
+        kslide_encoder_push_front_symbol(encoder, encoder_symbols + i * stride);
+        kslide_decoder_push_front_symbol(decoder, decoder_symbols + i * stride);
+    }
+    kslide_encoder_set_window(encoder, 0, symbols);
+    kslide_decoder_set_window(decoder, 0, symbols);
+
+    EXPECT_EQ(1U, kslide_encoder_is_aligned(encoder));
+    EXPECT_EQ(1U, kslide_decoder_is_aligned(decoder));
+
+    std::vector<uint8_t> coefficients(
+        kslide_encoder_coefficient_vector_size(encoder));
+
+    uint32_t seed = 0;
+    while (kslide_decoder_symbols_decoded(decoder) < symbols && seed < 1000U)
+    {
+        kslide_encoder_set_seed(encoder, seed++);
+        kslide_encoder_generate(encoder, coefficients.data());
+        kslide_encoder_write_symbol(encoder, unaligned, coefficients.data());
+        kslide_decoder_read_symbol(decoder, unaligned, coefficients.data());
+    }
+
+    for (uint64_t i = 0; i < symbols; ++i)
+    {
+        EXPECT_EQ(0, memcmp(encoder_symbols + i * stride,
+                            decoder_symbols + i * stride, symbol_size));
+    }
+
+    // An unaligned stream symbol disables the fast path until it is popped
+    kslide_encoder_push_front_symbol(encoder, unaligned);
+    kslide_decoder_push_front_symbol(decoder, unaligned);
+    EXPECT_EQ(0U, kslide_encoder_is_aligned(encoder));
+    EXPECT_EQ(0U, kslide_decoder_is_aligned(decoder));
+
+    while (kslide_encoder_stream_symbols(encoder) > 0)
+        kslide_encoder_pop_back_symbol(encoder);
+    while (kslide_decoder_stream_symbols(decoder) > 0)
+        kslide_decoder_pop_back_symbol(decoder);
+
+    EXPECT_EQ(1U, kslide_encoder_is_aligned(encoder));
+    EXPECT_EQ(1U, kslide_decoder_is_aligned(decoder));
+
+    kslide_delete_decoder(decoder);
+    kslide_delete_encoder(encoder);
+    kslide_delete_decoder_factory(decoder_factory);
+    kslide_delete_encoder_factory(encoder_factory);
+}
+
+namespace
+{
+struct fetch_context
+{
+    symbol_storage* m_storage;
+    uint64_t m_fetched;
+    uint64_t m_missing;
+};
+
+uint8_t fetch_symbol(void* context, uint64_t index, uint8_t* symbol)
+{
+    fetch_context* c = (fetch_context*) context;
+    if (index == c->m_missing)
+        return 0;
+
+    c->m_fetched++;
+    memcpy(symbol, symbol_storage_symbol(c->m_storage, index),
+           c->m_storage->m_symbol_size);
+    return 1;
+}
+}
+
+TEST(test_kodo_slide_c, pull_encoder)
+{
+    uint64_t symbols = 50U;
+    uint64_t symbol_size = 100U;
+
+    std::vector<int32_t> fields = {
+        kslide_binary, kslide_binary4, kslide_binary8, kslide_binary16};
+
+    for (int32_t field : fields)
+    {
+        kslide_encoder_factory_t* factory = kslide_new_encoder_factory();
+        kslide_encoder_factory_set_field(factory, field);
+        kslide_encoder_factory_set_symbol_size(factory, symbol_size);
+
+        // A regular encoder on the same data gives the expected symbols
+        kslide_encoder_t* encoder = kslide_encoder_factory_build(factory);
+        kslide_encoder_t* pull_encoder = kslide_encoder_factory_build(factory);
+
+        symbol_storage* storage = symbol_storage_alloc(symbols, symbol_size);
+        symbol_storage_randomize(storage);
+
+        fetch_context context = {storage, 0, UINT64_MAX};
+        kslide_pull_encoder_t* pull =
+            kslide_new_pull_encoder(pull_encoder, fetch_symbol, &context);
+
+        for (uint64_t i = 0; i < symbols; ++i)
+        {
+            EXPECT_EQ(i, kslide_pull_encoder_push_front_symbol(pull));
+            kslide_encoder_push_front_symbol(
+                encoder, symbol_storage_symbol(storage, i));
+        }
+
+        EXPECT_EQ(0U, kslide_pull_encoder_pop_back_symbol(pull));
+        kslide_encoder_pop_back_symbol(encoder);
+
+        kslide_encoder_set_window(encoder, 10, 30);
+        kslide_encoder_set_window(pull_encoder, 10, 30);
+
+        std::vector<uint8_t> coefficients(
+            kslide_encoder_coefficient_vector_size(encoder));
+        std::vector<uint8_t> expected(symbol_size);
+        std::vector<uint8_t> symbol(symbol_size);
+
+        for (uint32_t seed = 0; seed < 5; ++seed)
+        {
+            kslide_encoder_set_seed(pull_encoder, seed);
+            kslide_encoder_generate(pull_encoder, coefficients.data());
+
+            EXPECT_EQ(1U, kslide_pull_encoder_write_symbol(
+                pull, symbol.data(), coefficients.data()));
+            kslide_encoder_write_symbol(
+                encoder, expected.data(), coefficients.data());
+            EXPECT_EQ(expected, symbol);
+        }
+
+        // Only the window symbols are fetched
+        EXPECT_LE(context.m_fetched, 5 * 30U);
+        EXPECT_EQ(10U, kslide_encoder_window_lower_bound(pull_encoder));
+        EXPECT_EQ(30U, kslide_encoder_window_symbols(pull_encoder));
+
+        EXPECT_EQ(1U, kslide_pull_encoder_write_source_symbol(
+            pull, symbol.data(), 20));
+        EXPECT_EQ(0, memcmp(symbol.data(), symbol_storage_symbol(storage, 20),
+                            symbol_size));
+
+        // A failed fetch fails the write
+        std::fill(coefficients.begin(), coefficients.end(), 0xFF);
+        context.m_missing = 15;
+        EXPECT_EQ(0U, kslide_pull_encoder_write_symbol(
+            pull, symbol.data(), coefficients.data()));
+        EXPECT_EQ(0U, kslide_pull_encoder_write_source_symbol(
+            pull, symbol.data(), 15));
+
+        kslide_delete_pull_encoder(pull);
+        symbol_storage_free(storage);
+        kslide_delete_encoder(pull_encoder);
+        kslide_delete_encoder(encoder);
+        kslide_delete_encoder_factory(factory);
+    }
+}
+
+TEST(test_kodo_slide_c, block_mode)
+{
+    srand(static_cast<uint32_t>(time(0)));
+
+    uint64_t symbols = 20U;
+    uint64_t symbol_size = 16U;
+    uint64_t block_symbols = 8U;
+    uint64_t repairs = 3U;
+
+    kslide_encoder_factory_t* encoder_factory = kslide_new_encoder_factory();
+    kslide_decoder_factory_t* decoder_factory = kslide_new_decoder_factory();
+    kslide_encoder_factory_set_field(encoder_factory, kslide_binary8);
+    kslide_decoder_factory_set_field(decoder_factory, kslide_binary8);
+    kslide_encoder_factory_set_symbol_size(encoder_factory, symbol_size);
+    kslide_decoder_factory_set_symbol_size(decoder_factory, symbol_size);
+
+    kslide_encoder_t* encoder = kslide_encoder_factory_build(encoder_factory);
+    kslide_decoder_t* decoder = kslide_decoder_factory_build(decoder_factory);
+
+    EXPECT_EQ(0U, kslide_encoder_block_symbols(encoder));
+    kslide_encoder_set_block_symbols(encoder, block_symbols);
+    kslide_decoder_set_block_symbols(decoder, block_symbols);
+    EXPECT_EQ(block_symbols, kslide_encoder_block_symbols(encoder));
+    EXPECT_EQ(block_symbols, kslide_decoder_block_symbols(decoder));
+
+    symbol_storage* encoder_storage =
+        symbol_storage_alloc(symbols, symbol_size);
+    symbol_storage* decoder_storage =
+        symbol_storage_alloc(symbols, symbol_size);
+    symbol_storage_randomize(encoder_storage);
+
+    std::vector<uint8_t> symbol(symbol_size);
+    std::vector<uint8_t> coefficients(block_symbols);
+
+    for (uint64_t i = 0; i < symbols; ++i)
+    {
+        kslide_encoder_push_front_symbol(
+            encoder, symbol_storage_symbol(encoder_storage, i));
+        kslide_decoder_push_front_symbol(
+            decoder, symbol_storage_symbol(decoder_storage, i));
+
+        // The window covers the block of the newest symbol
+        uint64_t block = i / block_symbols;
+        EXPECT_EQ(block, kslide_encoder_block(encoder));
+        EXPECT_EQ(block * block_symbols,
+                  kslide_encoder_window_lower_bound(encoder));
+        EXPECT_EQ(i + 1, kslide_encoder_window_upper_bound(encoder));
+
+        // Send a block when it is full or at the end of the stream
+        if ((i + 1) % block_symbols != 0 && i + 1 != symbols)
+            continue;
+
+        uint64_t lower_bound = kslide_encoder_window_lower_bound(encoder);
+        uint64_t window_symbols = kslide_encoder_window_symbols(encoder);
+        uint64_t lost = rand() % (repairs + 1);
+
+        for (uint64_t j = lost; j < window_symbols; ++j)
+        {
+            kslide_encoder_write_source_symbol(
+                encoder, symbol.data(), lower_bound + j);
+            kslide_decoder_read_source_symbol(
+                decoder, symbol.data(), lower_bound + j);
+        }
+
+        for (uint64_t r = 0; r < lost; ++r)
+        {
+            kslide_encoder_write_block_symbol(
+                encoder, symbol.data(), coefficients.data(), r);
+            kslide_decoder_read_block_symbol(
+                decoder, symbol.data(), coefficients.data(), lower_bound,
+                window_symbols, r);
+        }
+
+        EXPECT_EQ(lower_bound + window_symbols,
+                  kslide_decoder_rank(decoder));
+    }
+
+    for (uint64_t i = 0; i < symbols; ++i)
+    {
+        EXPECT_EQ(0, memcmp(symbol_storage_symbol(encoder_storage, i),
+                            symbol_storage_symbol(decoder_storage, i),
+                            symbol_size));
+    }
+
+    // Switching back to sliding window keeps the window until it is set
+    kslide_encoder_set_block_symbols(encoder, 0);
+    kslide_encoder_pop_back_symbol(encoder);
+    EXPECT_EQ(16U, kslide_encoder_window_lower_bound(encoder));
+
+    symbol_storage_free(encoder_storage);
+    symbol_storage_free(decoder_storage);
+    kslide_delete_encoder(encoder);
+    kslide_delete_decoder(decoder);
+
+    // The encoder pops part of a block before its repair symbols are sent.
+    // The window then starts after the block and the decoder must use the
+    // window lower bound of the encoder.
+    encoder = kslide_encoder_factory_build(encoder_factory);
+    decoder = kslide_decoder_factory_build(decoder_factory);
+    kslide_encoder_set_block_symbols(encoder, block_symbols);
+    kslide_decoder_set_block_symbols(decoder, block_symbols);
+
+    encoder_storage = symbol_storage_alloc(block_symbols, symbol_size);
+    decoder_storage = symbol_storage_alloc(block_symbols, symbol_size);
+    symbol_storage_randomize(encoder_storage);
+
+    for (uint64_t i = 0; i < block_symbols; ++i)
+    {
+        kslide_encoder_push_front_symbol(
+            encoder, symbol_storage_symbol(encoder_storage, i));
+        kslide_decoder_push_front_symbol(
+            decoder, symbol_storage_symbol(decoder_storage, i));
+    }
+
+    for (uint64_t i = 0; i < 3; ++i)
+        kslide_encoder_pop_back_symbol(encoder);
+
+    uint64_t lower_bound = kslide_encoder_window_lower_bound(encoder);
+    uint64_t window_symbols = kslide_encoder_window_symbols(encoder);
+    EXPECT_EQ(3U, lower_bound);
+    EXPECT_EQ(5U, window_symbols);
+
+    // The first two symbols of the window are lost
+    for (uint64_t j = 2; j < window_symbols; ++j)
+    {
+        kslide_encoder_write_source_symbol(
+            encoder, symbol.data(), lower_bound + j);
+        kslide_decoder_read_source_symbol(
+            decoder, symbol.data(), lower_bound + j);
+    }
+
+    for (uint64_t r = 0; r < 2; ++r)
+    {
+        kslide_encoder_write_block_symbol(
+            encoder, symbol.data(), coefficients.data(), r);
+        kslide_decoder_read_block_symbol(
+            decoder, symbol.data(), coefficients.data(), lower_bound,
+            window_symbols, r);
+    }
+
+    for (uint64_t i = lower_bound; i < block_symbols; ++i)
+    {
+        EXPECT_EQ(1U, kslide_decoder_is_symbol_decoded(decoder, i));
+        EXPECT_EQ(0, memcmp(symbol_storage_symbol(encoder_storage, i),
+                            symbol_storage_symbol(decoder_storage, i),
+                            symbol_size));
+    }
+
+    symbol_storage_free(encoder_storage);
+    symbol_storage_free(decoder_storage);
+    kslide_delete_encoder(encoder);
+    kslide_delete_decoder(decoder);
+
+    // Repair symbols written before and after a pop belong to the same
+    // block code. Symbols 1 and 3 are lost and recovered from repair 0 of
+    // the full block and repair 1 written after symbol 0 was popped.
+    encoder = kslide_encoder_factory_build(encoder_factory);
+    decoder = kslide_decoder_factory_build(decoder_factory);
+    kslide_encoder_set_block_symbols(encoder, block_symbols);
+    kslide_decoder_set_block_symbols(decoder, block_symbols);
+
+    encoder_storage = symbol_storage_alloc(block_symbols, symbol_size);
+    decoder_storage = symbol_storage_alloc(block_symbols, symbol_size);
+    symbol_storage_randomize(encoder_storage);
+
+    for (uint64_t i = 0; i < block_symbols; ++i)
+    {
+        kslide_encoder_push_front_symbol(
+            encoder, symbol_storage_symbol(encoder_storage, i));
+        kslide_decoder_push_front_symbol(
+            decoder, symbol_storage_symbol(decoder_storage, i));
+    }
+
+    for (uint64_t i = 0; i < block_symbols; ++i)
+    {
+        if (i == 1 || i == 3)
+            continue;
+
+        kslide_encoder_write_source_symbol(encoder, symbol.data(), i);
+        kslide_decoder_read_source_symbol(decoder, symbol.data(), i);
+    }
+
+    kslide_encoder_write_block_symbol(
+        encoder, symbol.data(), coefficients.data(), 0);
+    kslide_decoder_read_block_symbol(
+        decoder, symbol.data(), coefficients.data(), 0, block_symbols, 0);
+
+    kslide_encoder_pop_back_symbol(encoder);
+    EXPECT_EQ(1U, kslide_encoder_window_lower_bound(encoder));
+
+    kslide_encoder_write_block_symbol(
+        encoder, symbol.data(), coefficients.data(), 1);
+    kslide_decoder_read_block_symbol(
+        decoder, symbol.data(), coefficients.data(), 1, block_symbols - 1, 1);
+
+    for (uint64_t i = 0; i < block_symbols; ++i)
+    {
+        EXPECT_EQ(1U, kslide_decoder_is_symbol_decoded(decoder, i));
+        EXPECT_EQ(0, memcmp(symbol_storage_symbol(encoder_storage, i),
+                            symbol_storage_symbol(decoder_storage, i),
+                            symbol_size));
+    }
+
+    symbol_storage_free(encoder_storage);
+    symbol_storage_free(decoder_storage);
+    kslide_delete_encoder(encoder);
+    kslide_delete_decoder(decoder);
+    kslide_delete_encoder_factory(encoder_factory);
+    kslide_delete_decoder_factory(decoder_factory);
+}
+
+TEST(test_kodo_slide_c, work_quota)
+{
+    uint64_t symbols = 10U;
+    uint64_t symbol_size = 16U;
+
+    kslide_encoder_factory_t* encoder_factory = kslide_new_encoder_factory();
+    kslide_decoder_factory_t* decoder_factory = kslide_new_decoder_factory();
+    kslide_encoder_factory_set_field(encoder_factory, kslide_binary8);
+    kslide_decoder_factory_set_field(decoder_factory, kslide_binary8);
+    kslide_encoder_factory_set_symbol_size(encoder_factory, symbol_size);
+    kslide_decoder_factory_set_symbol_size(decoder_factory, symbol_size);
+
+    kslide_encoder_t* encoder = kslide_encoder_factory_build(encoder_factory);
+    kslide_decoder_t* decoder = kslide_decoder_factory_build(decoder_factory);
+
+    symbol_storage* encoder_storage =
+        symbol_storage_alloc(symbols, symbol_size);
+    symbol_storage* decoder_storage =
+        symbol_storage_alloc(symbols, symbol_size);
+    symbol_storage_randomize(encoder_storage);
+
+    for (uint64_t i = 0; i < symbols; ++i)
+    {
+        kslide_encoder_push_front_symbol(
+            encoder, symbol_storage_symbol(encoder_storage, i));
+        kslide_decoder_push_front_symbol(
+            decoder, symbol_storage_symbol(decoder_storage, i));
+    }
+    kslide_encoder_set_window(encoder, 0, symbols);
+    kslide_decoder_set_window(decoder, 0, symbols);
+
+    EXPECT_EQ(UINT64_MAX, kslide_encoder_work_left(encoder));
+    EXPECT_EQ(UINT64_MAX, kslide_decoder_work_left(decoder));
+
+    kslide_encoder_set_work_quota(encoder, 25);
+    kslide_decoder_set_work_quota(decoder, 25);
+    EXPECT_EQ(25U, kslide_encoder_work_quota(encoder));
+    EXPECT_EQ(25U, kslide_decoder_work_quota(decoder));
+
+    std::vector<uint8_t> symbol(symbol_size);
+    std::vector<uint8_t> coefficients(
+        kslide_encoder_coefficient_vector_size(encoder));
+
+    // A source symbol costs 1
+    kslide_encoder_write_source_symbol(encoder, symbol.data(), 0);
+    kslide_decoder_read_source_symbol(decoder, symbol.data(), 0);
+    EXPECT_EQ(1U, kslide_encoder_work(encoder));
+    EXPECT_EQ(1U, kslide_decoder_work(decoder));
+
+    // Coded symbols cost the window symbols, the third one does not fit
+    for (uint32_t seed = 0; seed < 3; ++seed)
+    {
+        kslide_encoder_set_seed(encoder, seed);
+        kslide_encoder_generate(encoder, coefficients.data());
+        kslide_encoder_write_symbol(
+            encoder, symbol.data(), coefficients.data());
+        kslide_decoder_read_symbol(
+            decoder, symbol.data(), coefficients.data());
+    }
+    EXPECT_EQ(31U, kslide_encoder_work(encoder));
+    EXPECT_EQ(0U, kslide_encoder_work_left(encoder));
+    EXPECT_EQ(21U, kslide_decoder_work(decoder));
+    EXPECT_EQ(4U, kslide_decoder_work_left(decoder));
+    EXPECT_EQ(1U, kslide_decoder_pending_reads(decoder));
+
+    // Source symbols do not wait behind the coded symbols
+    kslide_encoder_write_source_symbol(encoder, symbol.data(), 1);
+    kslide_decoder_read_source_symbol(decoder, symbol.data(), 1);
+    EXPECT_EQ(1U, kslide_decoder_pending_reads(decoder));
+    EXPECT_EQ(4U, kslide_decoder_rank(decoder));
+    EXPECT_EQ(22U, kslide_decoder_work(decoder));
+
+    // A new period applies the deferred reads
+    kslide_decoder_reset_work(decoder);
+    EXPECT_EQ(0U, kslide_decoder_pending_reads(decoder));
+    EXPECT_EQ(10U, kslide_decoder_work(decoder));
+    EXPECT_EQ(5U, kslide_decoder_rank(decoder));
+
+    kslide_encoder_reset_work(encoder);
+    EXPECT_EQ(0U, kslide_encoder_work(encoder));
+
+    // Without a quota reads are applied right away again
+    kslide_decoder_set_work_quota(decoder, 0);
+    for (uint64_t i = 2; i < symbols; ++i)
+    {
+        kslide_encoder_write_source_symbol(encoder, symbol.data(), i);
+        kslide_decoder_read_source_symbol(decoder, symbol.data(), i);
+    }
+    EXPECT_EQ(symbols - 2, kslide_encoder_work(encoder));
+    EXPECT_EQ(symbols, kslide_decoder_rank(decoder));
+    EXPECT_EQ(symbols, kslide_decoder_symbols_decoded(decoder));
+
+    for (uint64_t i = 0; i < symbols; ++i)
+    {
+        EXPECT_EQ(0, memcmp(symbol_storage_symbol(encoder_storage, i),
+                            symbol_storage_symbol(decoder_storage, i),
+                            symbol_size));
+    }
+
+    // Stepping, a full queue and popping all respect the quota
+    kslide_decoder_set_work_quota(decoder, 15);
+    kslide_decoder_reset_work(decoder);
+    kslide_decoder_read_symbol(decoder, symbol.data(), coefficients.data());
+    EXPECT_EQ(10U, kslide_decoder_work(decoder));
+    kslide_decoder_read_symbol(decoder, symbol.data(), coefficients.data());
+    EXPECT_EQ(1U, kslide_decoder_step(decoder, 100));
+    EXPECT_EQ(10U, kslide_decoder_work(decoder));
+
+    EXPECT_EQ(1024U, kslide_decoder_max_pending_reads(decoder));
+    kslide_decoder_set_max_pending_reads(decoder, 1);
+    kslide_decoder_read_symbol(decoder, symbol.data(), coefficients.data());
+    EXPECT_EQ(1U, kslide_decoder_pending_reads(decoder));
+    EXPECT_EQ(1U, kslide_decoder_dropped_reads(decoder));
+
+    kslide_decoder_pop_back_symbol(decoder);
+    EXPECT_EQ(0U, kslide_decoder_pending_reads(decoder));
+    EXPECT_EQ(2U, kslide_decoder_dropped_reads(decoder));
+    EXPECT_EQ(10U, kslide_decoder_work(decoder));
+
+    // A quota smaller than the window: the coded reads can never fit, so
+    // they are dropped instead of blocking the queue, and source reads are
+    // still applied
+    kslide_decoder_set_max_pending_reads(decoder, 4);
+    kslide_decoder_set_work_quota(decoder, 5);
+    kslide_decoder_reset_work(decoder);
+    EXPECT_EQ(symbols - 1, kslide_decoder_window_symbols(decoder));
+    for (uint32_t i = 0; i < 10; ++i)
+    {
+        kslide_decoder_read_symbol(
+            decoder, symbol.data(), coefficients.data());
+    }
+    EXPECT_EQ(0U, kslide_decoder_pending_reads(decoder));
+    EXPECT_EQ(12U, kslide_decoder_dropped_reads(decoder));
+    EXPECT_EQ(0U, kslide_decoder_step(decoder, 100));
+
+    kslide_decoder_read_source_symbol(decoder, symbol.data(), 5);
+    EXPECT_EQ(1U, kslide_decoder_work(decoder));
+
+    // Lowering the quota below the window of queued reads drops them at the
+    // start of the next period
+    kslide_decoder_set_work_quota(decoder, 0);
+    kslide_decoder_set_read_budget(decoder, 1);
+    kslide_decoder_read_symbol(decoder, symbol.data(), coefficients.data());
+    EXPECT_EQ(1U, kslide_decoder_pending_reads(decoder));
+    kslide_decoder_set_work_quota(decoder, 5);
+    kslide_decoder_reset_work(decoder);
+    EXPECT_EQ(0U, kslide_decoder_pending_reads(decoder));
+    EXPECT_EQ(13U, kslide_decoder_dropped_reads(decoder));
+
+    symbol_storage_free(encoder_storage);
+    symbol_storage_free(decoder_storage);
+    kslide_delete_encoder(encoder);
+    kslide_delete_decoder(decoder);
+    kslide_delete_encoder_factory(encoder_factory);
+    kslide_delete_decoder_factory(decoder_factory);
+}
+
+TEST(test_kodo_slide_c, counter_generator)
+{
+    uint64_t symbols = 40U;
+    uint64_t symbol_size = 16U;
+
+    std::vector<int32_t> fields = {
+        kslide_binary, kslide_binary4, kslide_binary8, kslide_binary16};
+
+    for (int32_t field : fields)
+    {
+        kslide_encoder_factory_t* encoder_factory = kslide_new_encoder_factory();
+        kslide_decoder_factory_t* decoder_factory = kslide_new_decoder_factory();
+        kslide_encoder_factory_set_field(encoder_factory, field);
+        kslide_decoder_factory_set_field(decoder_factory, field);
+        kslide_encoder_factory_set_symbol_size(encoder_factory, symbol_size);
+        kslide_decoder_factory_set_symbol_size(decoder_factory, symbol_size);
+
+        EXPECT_EQ(kslide_generator_default,
+                  kslide_encoder_factory_generator(encoder_factory));
+        kslide_encoder_factory_set_generator(
+            encoder_factory, kslide_generator_counter);
+        kslide_decoder_factory_set_generator(
+            decoder_factory, kslide_generator_counter);
+        EXPECT_EQ(kslide_generator_counter,
+                  kslide_decoder_factory_generator(decoder_factory));
+
+        kslide_encoder_t* encoder =
+            kslide_encoder_factory_build(encoder_factory);
+        kslide_decoder_t* decoder =
+            kslide_decoder_factory_build(decoder_factory);
+        EXPECT_EQ(kslide_generator_counter, kslide_encoder_generator(encoder));
+        EXPECT_EQ(kslide_generator_counter, kslide_decoder_generator(decoder));
+
+        symbol_storage* encoder_storage =
+            symbol_storage_alloc(symbols, symbol_size);
+        symbol_storage* decoder_storage =
+            symbol_storage_alloc(symbols, symbol_size);
+        symbol_storage_randomize(encoder_storage);
+
+        for (uint64_t i = 0; i < symbols; ++i)
+        {
+            kslide_encoder_push_front_symbol(
+                encoder, symbol_storage_symbol(encoder_storage, i));
+            kslide_decoder_push_front_symbol(
+                decoder, symbol_storage_symbol(decoder_storage, i));
+        }
+
+        kslide_encoder_set_window(encoder, 0, symbols);
+
+        std::vector<uint8_t> symbol(symbol_size);
+        std::vector<uint8_t> coefficients(
+            kslide_encoder_coefficient_vector_size(encoder));
+        std::vector<uint8_t> slice(coefficients.size());
+
+        // A coefficient only depends on the seed and its stream index
+        kslide_encoder_set_window(encoder, 3, 30);
+        kslide_encoder_set_seed(encoder, 7);
+        kslide_encoder_generate(encoder, coefficients.data());
+        kslide_generate_counter_coefficients(field, 7, 13, 20, slice.data());
+
+        uint32_t bits = field == kslide_binary ? 1 :
+                        field == kslide_binary4 ? 4 :
+                        field == kslide_binary8 ? 8 : 16;
+        for (uint64_t i = 0; i < 20; ++i)
+        {
+            uint64_t a = 10 + i;
+            uint32_t expected = 0;
+            uint32_t actual = 0;
+            for (uint32_t b = 0; b < bits; ++b)
+            {
+                uint64_t bit = a * bits + b;
+                expected |= ((coefficients[bit / 8] >> (bit % 8)) & 1) << b;
+                actual |= ((slice[(i * bits + b) / 8] >>
+                            ((i * bits + b) % 8)) & 1) << b;
+            }
+            EXPECT_EQ(expected, actual);
+        }
+
+        // The decoder generates the same coefficients and decodes
+        uint32_t seed = 0;
+        kslide_encoder_set_window(encoder, 0, symbols);
+        kslide_decoder_set_window(decoder, 0, symbols);
+        while (kslide_decoder_rank(decoder) < symbols)
+        {
+            ASSERT_LT(seed, 100U * symbols);
+            kslide_encoder_set_seed(encoder, seed);
+            kslide_encoder_generate(encoder, coefficients.data());
+            kslide_encoder_write_symbol(
+                encoder, symbol.data(), coefficients.data());
+
+            kslide_decoder_set_seed(decoder, seed);
+            kslide_decoder_generate(decoder, slice.data());
+            EXPECT_EQ(coefficients, slice);
+            kslide_decoder_read_symbol(decoder, symbol.data(), slice.data());
+            ++seed;
+        }
+
+        for (uint64_t i = 0; i < symbols; ++i)
+        {
+            EXPECT_EQ(0, memcmp(symbol_storage_symbol(encoder_storage, i),
+                                symbol_storage_symbol(decoder_storage, i),
+                                symbol_size));
+        }
+
+        symbol_storage_free(encoder_storage);
+        symbol_storage_free(decoder_storage);
+        kslide_delete_encoder(encoder);
+        kslide_delete_decoder(decoder);
+        kslide_delete_encoder_factory(encoder_factory);
+        kslide_delete_decoder_factory(decoder_factory);
+    }
+}
+
+TEST(test_kodo_slide_c, compress_allocations)
+{
+    uint64_t symbols = 1000U;
+
+    allocation_counter counter;
+    kslide_allocator allocator =
+    {
+        counting_malloc, counting_aligned_alloc, counting_free, &counter
+    };
+    kslide_set_allocator(&allocator);
+
+    std::vector<uint8_t> coefficients(symbols, 0);
+    std::vector<uint8_t> output(symbols);
+    std::vector<uint8_t> data(
+        kslide_coefficients_max_compressed_size(kslide_binary8, symbols));
+
+    // A clustered vector uses the runs representation and a scattered one
+    // the sparse representation. Neither may allocate per packet.
+    for (uint64_t i = 500; i < 504; ++i)
+        coefficients[i] = 1;
+    for (uint64_t i = 0; i < symbols; i += 97)
+        coefficients[i] = 2;
+
+    for (uint32_t i = 0; i < 2; ++i)
+    {
+        uint64_t size = kslide_compress_coefficients(
+            kslide_binary8, symbols, coefficients.data(), data.data());
+        EXPECT_EQ(size, kslide_decompress_coefficients(
+            kslide_binary8, symbols, data.data(), size, output.data()));
+        EXPECT_EQ(coefficients, output);
+
+        std::fill(coefficients.begin(), coefficients.end(), 0);
+        for (uint64_t j = 100; j < 110; ++j)
+            coefficients[j] = 3;
+    }
+
+    EXPECT_EQ(0U, counter.m_allocations);
+    EXPECT_EQ(0U, counter.m_aligned_allocations);
+
+    kslide_set_allocator(NULL);
+}
@@ -0,0 +1,231 @@
+// Copyright Steinwurf ApS 2018.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+// Reader for the trace files written by kslide_encoder_dump_trace() and
+// kslide_decoder_dump_trace(). Prints the events with their time relative
+// to the first event, followed by a summary. For decoder traces the
+// summary contains the in-order delivery delay of the symbols, i.e. the
+// time from a symbol being pushed until the decoded prefix moved past it,
+// and the symbols with the largest delay together with the number of
+// innovative and redundant symbols read in the meantime.
+//
+// Usage:
+//
+//     kodo_slide_c_trace_reader [--events=0] [--slowest=10] trace_file
+
+#include <kodo_slide_c/kodo_slide_c.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace
+{
+struct delivery
+{
+    uint64_t m_index;
+    uint64_t m_pushed;
+    uint64_t m_delivered;
+    uint64_t m_innovative = 0;
+    uint64_t m_redundant = 0;
+};
+
+const char* event_name(int32_t type)
+{
+    switch (type)
+    {
+    case kslide_trace_push_front_symbol:
+        return "push";
+    case kslide_trace_pop_back_symbol:
+        return "pop";
+    case kslide_trace_set_window:
+        return "window";
+    case kslide_trace_coded_symbol:
+        return "coded";
+    case kslide_trace_source_symbol:
+        return "source";
+    default:
+        return "unknown";
+    }
+}
+
+bool read_trace(const char* path, std::vector<kslide_trace_event>& events)
+{
+    FILE* file = fopen(path, "rb");
+    if (file == nullptr)
+        return false;
+
+    kslide_trace_header header;
+    bool ok = fread(&header, sizeof(header), 1, file) == 1 &&
+              header.m_magic == kslide_trace_magic &&
+              header.m_version == kslide_trace_version;
+
+    if (ok)
+    {
+        events.resize(header.m_events);
+        ok = fread(events.data(), sizeof(kslide_trace_event),
+                   events.size(), file) == events.size();
+    }
+
+    fclose(file);
+    return ok;
+}
+
+void print_events(const std::vector<kslide_trace_event>& events)
+{
+    printf("%12s %-8s %10s %8s %8s %10s %s\n", "time_us", "event", "index",
+           "symbols", "rank", "prefix", "innovative");
+
+    for (const kslide_trace_event& e : events)
+    {
+        printf("%12.1f %-8s %10llu %8llu %8llu %10llu %u\n",
+               (e.m_time - events[0].m_time) / 1000.0, event_name(e.m_type),
+               (unsigned long long) e.m_index,
+               (unsigned long long) e.m_symbols,
+               (unsigned long long) e.m_rank,
+               (unsigned long long) e.m_value, e.m_innovative);
+    }
+}
+
+void print_summary(const std::vector<kslide_trace_event>& events,
+                   uint64_t slowest)
+{
+    std::map<int32_t, uint64_t> counts;
+    uint64_t innovative = 0;
+    uint64_t reads = 0;
+
+    // The symbols pushed but not yet delivered, by stream index
+    std::map<uint64_t, delivery> pending;
+    std::vector<delivery> delivered;
+
+    for (const kslide_trace_event& e : events)
+    {
+        counts[e.m_type]++;
+
+        if (e.m_type == kslide_trace_push_front_symbol)
+        {
+            delivery& d = pending[e.m_index];
+            d.m_index = e.m_index;
+            d.m_pushed = e.m_time;
+        }
+        else if (e.m_type == kslide_trace_pop_back_symbol)
+        {
+            pending.erase(e.m_index);
+        }
+        else if (e.m_type == kslide_trace_coded_symbol ||
+                 e.m_type == kslide_trace_source_symbol)
+        {
+            reads++;
+            innovative += e.m_innovative;
+
+            for (auto& p : pending)
+            {
+                p.second.m_innovative += e.m_innovative;
+                p.second.m_redundant += 1 - e.m_innovative;
+            }
+
+            // Encoder events have no prefix
+            while (!pending.empty() && pending.begin()->first < e.m_value)
+            {
+                delivery d = pending.begin()->second;
+                d.m_delivered = e.m_time;
+                delivered.push_back(d);
+                pending.erase(pending.begin());
+            }
+        }
+    }
+
+    printf("\nevents: %llu", (unsigned long long) events.size());
+    for (auto& c : counts)
+        printf(", %s: %llu", event_name(c.first), (unsigned long long) c.second);
+    printf("\n");
+
+    if (delivered.empty())
+        return;
+
+    printf("reads: %llu, innovative: %llu\n", (unsigned long long) reads,
+           (unsigned long long) innovative);
+
+    std::sort(delivered.begin(), delivered.end(),
+              [](const delivery& a, const delivery& b)
+              {
+                  return a.m_delivered - a.m_pushed > b.m_delivered - b.m_pushed;
+              });
+
+    double total = 0;
+    for (const delivery& d : delivered)
+        total += d.m_delivered - d.m_pushed;
+
+    printf("delivered: %llu, undelivered: %llu, mean delay: %.1f us, "
+           "max delay: %.1f us\n",
+           (unsigned long long) delivered.size(),
+           (unsigned long long) pending.size(),
+           total / delivered.size() / 1000.0,
+           (delivered[0].m_delivered - delivered[0].m_pushed) / 1000.0);
+
+    printf("\n%10s %12s %12s %10s\n", "index", "delay_us", "innovative",
+           "redundant");
+    for (uint64_t i = 0; i < slowest && i < delivered.size(); ++i)
+    {
+        const delivery& d = delivered[i];
+        printf("%10llu %12.1f %12llu %10llu\n", (unsigned long long) d.m_index,
+               (d.m_delivered - d.m_pushed) / 1000.0,
+               (unsigned long long) d.m_innovative,
+               (unsigned long long) d.m_redundant);
+    }
+}
+
+void print_usage(const char* program)
+{
+    printf("Usage: %s [--events=0|1] [--slowest=N] trace_file\n", program);
+}
+}
+
+int main(int argc, char* argv[])
+{
+    bool show_events = true;
+    uint64_t slowest = 10;
+    const char* path = nullptr;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string argument = argv[i];
+
+        if (argument.compare(0, 9, "--events=") == 0)
+            show_events = argument.substr(9) != "0";
+        else if (argument.compare(0, 10, "--slowest=") == 0)
+            slowest = strtoull(argument.substr(10).c_str(), nullptr, 10);
+        else if (argument.compare(0, 2, "--") != 0 && path == nullptr)
+            path = argv[i];
+        else
+        {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (path == nullptr)
+    {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    std::vector<kslide_trace_event> events;
+    if (!read_trace(path, events))
+    {
+        printf("Could not read trace file: %s\n", path);
+        return 1;
+    }
+
+    if (show_events && !events.empty())
+        print_events(events);
+
+    print_summary(events, slowest);
+    return 0;
+}